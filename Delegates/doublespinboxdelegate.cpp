@@ -59,8 +59,8 @@
 
 #include <QSpinBox>
 
-DoubleSpinBoxDelegate::DoubleSpinBoxDelegate(QString suffix, QObject *parent)
-    : QStyledItemDelegate(parent), suffix_{suffix}
+DoubleSpinBoxDelegate::DoubleSpinBoxDelegate(QString suffix, QObject *parent, double minimum, double maximum, int decimals)
+    : QStyledItemDelegate(parent), suffix_{suffix}, minimum_{minimum}, maximum_{maximum}, decimals_{decimals}
 {
 }
 
@@ -70,9 +70,9 @@ QWidget *DoubleSpinBoxDelegate::createEditor(QWidget *parent,
 {
     QDoubleSpinBox *editor = new QDoubleSpinBox(parent);
     editor->setFrame(false);
-    editor->setDecimals(4);
-    editor->setMinimum(0);
-    editor->setMaximum(999999);
+    editor->setDecimals(decimals_);
+    editor->setMinimum(minimum_);
+    editor->setMaximum(maximum_);
     editor->setSuffix(suffix_);
 
     return editor;
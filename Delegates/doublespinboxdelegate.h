@@ -58,7 +58,7 @@ class DoubleSpinBoxDelegate : public QStyledItemDelegate
     Q_OBJECT
 
 public:
-    DoubleSpinBoxDelegate(QString suffix = "", QObject *parent = 0);
+    DoubleSpinBoxDelegate(QString suffix = "", QObject *parent = 0, double minimum = 0, double maximum = 999999, int decimals = 4);
 
     QWidget *createEditor(QWidget *parent, const QStyleOptionViewItem &option,
                           const QModelIndex &index) const override;
@@ -72,6 +72,9 @@ public:
 
 private:
     QString suffix_;
+    double minimum_;
+    double maximum_;
+    int decimals_;
 };
 
 #endif
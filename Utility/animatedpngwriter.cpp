@@ -0,0 +1,242 @@
+/*
+ *  VieSched++ Very Long Baseline Interferometry (VLBI) Scheduling Software
+ *  Copyright (C) 2018  Matthias Schartner
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "animatedpngwriter.h"
+
+#include <QList>
+#include <QPair>
+#include <QVector>
+
+#include <cstring>
+
+namespace{
+    const char pngSignature[8] = {static_cast<char>(137), 'P', 'N', 'G', '\r', '\n', 26, '\n'};
+}
+
+AnimatedPngWriter::AnimatedPngWriter():
+    actlOffset_{0}, nFrames_{0}, written_{0}, sequence_{0}, delay_{100}
+{
+}
+
+AnimatedPngWriter::~AnimatedPngWriter()
+{
+    if(file_.isOpen()){
+        close();
+    }
+}
+
+bool AnimatedPngWriter::open(const QString &fileName, int nFrames, int delay)
+{
+    if(file_.isOpen()){
+        close();
+    }
+    header_.clear();
+    actlOffset_ = 0;
+    nFrames_ = nFrames;
+    written_ = 0;
+    sequence_ = 0;
+    delay_ = static_cast<quint16>(qBound(1, delay, 65535));
+    error_.clear();
+
+    file_.setFileName(fileName);
+    if(!file_.open(QIODevice::WriteOnly | QIODevice::Truncate)){
+        error_ = file_.errorString();
+        return false;
+    }
+    return true;
+}
+
+bool AnimatedPngWriter::addFrame(const QByteArray &png)
+{
+    if(!file_.isOpen()){
+        error_ = "file is not open";
+        return false;
+    }
+    if(png.size() < 8 || memcmp(png.constData(), pngSignature, 8) != 0){
+        error_ = "frame is not a png file";
+        return false;
+    }
+
+    // split frame into chunks, the data is not copied
+    QByteArray ihdr;
+    QVector<QByteArray> idat;
+    QList<QPair<QByteArray, QByteArray>> ancillary;
+    const char *d = png.constData();
+    int pos = 8;
+    while(pos + 12 <= png.size()){
+        quint32 len = readUInt32(d + pos);
+        if(len > static_cast<quint32>(png.size() - pos - 12)){
+            error_ = "truncated png frame";
+            return false;
+        }
+        QByteArray type = QByteArray::fromRawData(d + pos + 4, 4);
+        QByteArray data = QByteArray::fromRawData(d + pos + 8, static_cast<int>(len));
+        if(type == "IHDR"){
+            ihdr = data;
+        }else if(type == "IDAT"){
+            idat.append(data);
+        }else if(type == "IEND"){
+            break;
+        }else if(idat.isEmpty() && type != "acTL" && type != "fcTL"){
+            // chunks in front of the image data (palette, gamma, ...) are taken from the first frame
+            ancillary.append(qMakePair(type, data));
+        }
+        pos += 12 + static_cast<int>(len);
+    }
+    if(ihdr.size() != 13 || idat.isEmpty()){
+        error_ = "invalid png frame";
+        return false;
+    }
+
+    if(written_ == 0){
+        header_ = QByteArray(ihdr.constData(), ihdr.size());
+        file_.write(pngSignature, 8);
+        writeChunk("IHDR", header_);
+        actlOffset_ = file_.pos();
+        writeChunk("acTL", actl(static_cast<quint32>(nFrames_)));
+        for(const auto &any : ancillary){
+            writeChunk(any.first.constData(), any.second);
+        }
+    }else if(ihdr != header_){
+        error_ = "frame size or format differs from first frame";
+        return false;
+    }
+
+    // full frames: no offset, no disposal, frame replaces canvas
+    QByteArray fctl;
+    appendUInt32(fctl, sequence_++);
+    fctl.append(header_.constData(), 8);
+    appendUInt32(fctl, 0);
+    appendUInt32(fctl, 0);
+    appendUInt16(fctl, delay_);
+    appendUInt16(fctl, 1000);
+    fctl.append(static_cast<char>(0));
+    fctl.append(static_cast<char>(0));
+    writeChunk("fcTL", fctl);
+
+    // image data of first frame doubles as default image, all others are stored as frame data
+    for(const QByteArray &data : idat){
+        if(written_ == 0){
+            writeChunk("IDAT", data);
+        }else{
+            QByteArray fdat;
+            fdat.reserve(data.size() + 4);
+            appendUInt32(fdat, sequence_++);
+            fdat.append(data);
+            writeChunk("fdAT", fdat);
+        }
+    }
+    ++written_;
+
+    if(file_.error() != QFileDevice::NoError){
+        error_ = file_.errorString();
+        return false;
+    }
+    return true;
+}
+
+bool AnimatedPngWriter::close()
+{
+    if(!file_.isOpen()){
+        return false;
+    }
+    if(written_ == 0){
+        error_ = "no frames added";
+        file_.close();
+        file_.remove();
+        return false;
+    }
+
+    writeChunk("IEND", QByteArray());
+    if(written_ != nFrames_){
+        file_.seek(actlOffset_);
+        writeChunk("acTL", actl(static_cast<quint32>(written_)));
+    }
+
+    bool ok = file_.error() == QFileDevice::NoError;
+    if(!ok){
+        error_ = file_.errorString();
+    }
+    file_.close();
+    return ok;
+}
+
+void AnimatedPngWriter::writeChunk(const char *type, const QByteArray &data)
+{
+    QByteArray chunk;
+    chunk.reserve(data.size() + 12);
+    appendUInt32(chunk, static_cast<quint32>(data.size()));
+    chunk.append(type, 4);
+    chunk.append(data);
+    appendUInt32(chunk, crc(type, data));
+    file_.write(chunk);
+}
+
+QByteArray AnimatedPngWriter::actl(quint32 nFrames)
+{
+    QByteArray data;
+    appendUInt32(data, nFrames);
+    appendUInt32(data, 0);          // loop forever
+    return data;
+}
+
+void AnimatedPngWriter::appendUInt32(QByteArray &data, quint32 value)
+{
+    data.append(static_cast<char>((value >> 24) & 0xff));
+    data.append(static_cast<char>((value >> 16) & 0xff));
+    data.append(static_cast<char>((value >> 8) & 0xff));
+    data.append(static_cast<char>(value & 0xff));
+}
+
+void AnimatedPngWriter::appendUInt16(QByteArray &data, quint16 value)
+{
+    data.append(static_cast<char>((value >> 8) & 0xff));
+    data.append(static_cast<char>(value & 0xff));
+}
+
+quint32 AnimatedPngWriter::readUInt32(const char *p)
+{
+    const unsigned char *u = reinterpret_cast<const unsigned char *>(p);
+    return (static_cast<quint32>(u[0]) << 24) | (static_cast<quint32>(u[1]) << 16) |
+           (static_cast<quint32>(u[2]) << 8) | static_cast<quint32>(u[3]);
+}
+
+quint32 AnimatedPngWriter::crc(const char *type, const QByteArray &data)
+{
+    static const QVector<quint32> table = [](){
+        QVector<quint32> t(256);
+        for(quint32 n = 0; n < 256; ++n){
+            quint32 c = n;
+            for(int k = 0; k < 8; ++k){
+                c = (c & 1) ? 0xedb88320u ^ (c >> 1) : c >> 1;
+            }
+            t[n] = c;
+        }
+        return t;
+    }();
+
+    quint32 c = 0xffffffffu;
+    auto update = [&c](const char *p, int n){
+        for(int i = 0; i < n; ++i){
+            c = table[(c ^ static_cast<unsigned char>(p[i])) & 0xff] ^ (c >> 8);
+        }
+    };
+    update(type, 4);
+    update(data.constData(), data.size());
+    return c ^ 0xffffffffu;
+}
@@ -0,0 +1,105 @@
+/*
+ *  VieSched++ Very Long Baseline Interferometry (VLBI) Scheduling Software
+ *  Copyright (C) 2018  Matthias Schartner
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ANIMATEDPNGWRITER_H
+#define ANIMATEDPNGWRITER_H
+
+#include <QByteArray>
+#include <QFile>
+#include <QString>
+
+/**
+ * @brief streaming writer for animated png (APNG) files
+ *
+ * Frames are passed as already encoded png files (e.g. written by QImage::save), the compressed image data of each
+ * frame is copied into the animation without decoding. Every frame is written to disk as soon as it is added, so
+ * memory usage does not depend on the number of frames.
+ *
+ * All frames must have the same size, bit depth and color type as the first frame.
+ */
+class AnimatedPngWriter
+{
+public:
+
+    AnimatedPngWriter();
+
+    ~AnimatedPngWriter();
+
+    /**
+     * @brief create output file
+     *
+     * @param fileName output file
+     * @param nFrames number of frames which will be added
+     * @param delay display time of each frame in milliseconds
+     * @return true if file could be opened
+     */
+    bool open(const QString &fileName, int nFrames, int delay);
+
+    /**
+     * @brief append frame
+     *
+     * @param png png encoded frame
+     * @return true if frame was written
+     */
+    bool addFrame(const QByteArray &png);
+
+    /**
+     * @brief finish file
+     *
+     * If less frames than announced in open() were added, the frame count of the file is corrected.
+     *
+     * @return true if file was written successfully
+     */
+    bool close();
+
+    bool isOpen() const{
+        return file_.isOpen();
+    }
+
+    int frameCount() const{
+        return written_;
+    }
+
+    const QString &errorString() const{
+        return error_;
+    }
+
+private:
+    QFile file_;                    ///< output file
+    QByteArray header_;             ///< IHDR data of first frame
+    qint64 actlOffset_;             ///< file offset of acTL chunk
+    int nFrames_;                   ///< announced number of frames
+    int written_;                   ///< number of written frames
+    quint32 sequence_;              ///< sequence number of next fcTL or fdAT chunk
+    quint16 delay_;                 ///< frame delay in milliseconds
+    QString error_;                 ///< last error
+
+    void writeChunk(const char *type, const QByteArray &data);
+
+    static QByteArray actl(quint32 nFrames);
+
+    static void appendUInt32(QByteArray &data, quint32 value);
+
+    static void appendUInt16(QByteArray &data, quint16 value);
+
+    static quint32 readUInt32(const char *p);
+
+    static quint32 crc(const char *type, const QByteArray &data);
+};
+
+#endif // ANIMATEDPNGWRITER_H
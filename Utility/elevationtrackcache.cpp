@@ -0,0 +1,61 @@
+/*
+ *  VieSched++ Very Long Baseline Interferometry (VLBI) Scheduling Software
+ *  Copyright (C) 2018  Matthias Schartner
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "elevationtrackcache.h"
+
+ElevationTrackCache::ElevationTrackCache():
+    nsta_{0}, nSamples_{0}, step_{defaultStep}
+{
+}
+
+void ElevationTrackCache::compute(const VieVS::Scheduler &schedule, int duration, int step)
+{
+    const std::vector<VieVS::Source> &sources = schedule.getSources();
+    int nsrc = sources.size();
+    nsta_ = schedule.getNetwork().getNSta();
+    step_ = step;
+    nSamples_ = sampleCount(duration, step);
+
+    data_ = QVector<float>(nsrc*nsta_*nSamples_);
+    float *out = data_.data();
+
+    #pragma omp parallel
+    {
+        std::vector<VieVS::Station> stations = schedule.getNetwork().getStations();
+
+        #pragma omp for schedule(dynamic)
+        for(int srcid=0; srcid<nsrc; ++srcid){
+            computeSource(stations, sources[srcid], step, nSamples_, out + static_cast<size_t>(srcid)*nsta_*nSamples_);
+        }
+    }
+}
+
+void ElevationTrackCache::computeSource(std::vector<VieVS::Station> &stations, const VieVS::Source &source, int step,
+                                        int nSamples, float *out)
+{
+    for(VieVS::Station &sta : stations){
+        for(int k=0; k<nSamples; ++k){
+            VieVS::PointingVector pv(sta.getId(),source.getId());
+            pv.setTime(k*step);
+
+            sta.calcAzEl_rigorous(source,pv);
+            out[k] = static_cast<float>(pv.getEl()*rad2deg);
+        }
+        out += nSamples;
+    }
+}
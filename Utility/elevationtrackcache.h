@@ -0,0 +1,103 @@
+/*
+ *  VieSched++ Very Long Baseline Interferometry (VLBI) Scheduling Software
+ *  Copyright (C) 2018  Matthias Schartner
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ELEVATIONTRACKCACHE_H
+#define ELEVATIONTRACKCACHE_H
+
+#include <QVector>
+
+#include "../VieSchedpp/Scheduler.h"
+
+/**
+ * @brief elevation of every source at every station, sampled over the whole session
+ *
+ * Elevations are stored as float in degrees in one buffer (source, station, sample). Sample k belongs to time
+ * k*step seconds after session start. The sources are computed in parallel (OpenMP), every thread works on its own
+ * copy of the stations because Station::calcAzEl_rigorous is not const.
+ */
+class ElevationTrackCache
+{
+public:
+
+    static const int defaultStep = 300; ///< default time between samples in seconds
+
+    ElevationTrackCache();
+
+    /**
+     * @brief compute elevation tracks of all sources
+     *
+     * Usually called from a worker thread, the cache must not be accessed before it returns.
+     *
+     * @param schedule schedule
+     * @param duration session duration in seconds
+     * @param step time between samples in seconds
+     */
+    void compute(const VieVS::Scheduler &schedule, int duration, int step = defaultStep);
+
+    /**
+     * @brief compute elevation track of one source at all stations
+     *
+     * @param stations stations (modified by calcAzEl_rigorous)
+     * @param source source
+     * @param step time between samples in seconds
+     * @param nSamples number of samples
+     * @param out output buffer (stations.size() * nSamples values)
+     */
+    static void computeSource(std::vector<VieVS::Station> &stations, const VieVS::Source &source, int step,
+                              int nSamples, float *out);
+
+    /**
+     * @brief number of samples for a session
+     *
+     * Sampling ends one step after the session end.
+     *
+     * @param duration session duration in seconds
+     * @param step time between samples in seconds
+     * @return number of samples
+     */
+    static int sampleCount(int duration, int step){
+        return (duration+step)/step + 1;
+    }
+
+    int step() const{
+        return step_;
+    }
+
+    int samples() const{
+        return nSamples_;
+    }
+
+    /**
+     * @brief elevation track of one source at one station
+     *
+     * @param srcid source id
+     * @param staid station id
+     * @return pointer to samples() elevations [deg]
+     */
+    const float *track(int srcid, int staid) const{
+        return data_.constData() + (static_cast<size_t>(srcid)*nsta_ + staid)*nSamples_;
+    }
+
+private:
+    QVector<float> data_;           ///< elevations [deg] (source, station, sample)
+    int nsta_;
+    int nSamples_;
+    int step_;
+};
+
+#endif // ELEVATIONTRACKCACHE_H
@@ -0,0 +1,103 @@
+/*
+ *  VieSched++ Very Long Baseline Interferometry (VLBI) Scheduling Software
+ *  Copyright (C) 2018  Matthias Schartner
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "histogram.h"
+
+#include <algorithm>
+
+Histogram::Histogram():
+    underflow_{0}, overflow_{0}, cached_{false}, start_{0}, end_{0}
+{
+}
+
+Histogram::Histogram(const QVector<double> &edges):
+    Histogram()
+{
+    setEdges(edges);
+}
+
+QVector<double> Histogram::uniformEdges(double first, double width, int nBins)
+{
+    QVector<double> edges(std::max(nBins, 0) + 1);
+    for(int i = 0; i<edges.size(); ++i){
+        edges[i] = first + i*width;
+    }
+    return edges;
+}
+
+void Histogram::setEdges(const QVector<double> &edges)
+{
+    edges_ = edges;
+    counts_.fill(0, std::max(edges_.size() - 1, 0));
+    underflow_ = 0;
+    overflow_ = 0;
+    cached_ = false;
+}
+
+void Histogram::fill(const QVector<double> &values, bool sorted)
+{
+    counts_.fill(0);
+    underflow_ = 0;
+    overflow_ = 0;
+    cached_ = false;
+    if(edges_.isEmpty()){
+        return;
+    }
+
+    int n = counts_.size();
+    if(sorted){
+        // both sequences are ascending, the bin index only moves forward
+        int bin = -1;
+        for(double v : values){
+            while(bin < n && v >= edges_[bin+1]){
+                ++bin;
+            }
+            if(bin < 0){
+                ++underflow_;
+            }else if(bin >= n){
+                ++overflow_;
+            }else{
+                ++counts_[bin];
+            }
+        }
+    }else{
+        for(double v : values){
+            int bin = static_cast<int>(std::upper_bound(edges_.constBegin(), edges_.constEnd(), v) - edges_.constBegin()) - 1;
+            if(bin < 0){
+                ++underflow_;
+            }else if(bin >= n){
+                ++overflow_;
+            }else{
+                ++counts_[bin];
+            }
+        }
+    }
+}
+
+void Histogram::fill(int start, int end, const QVector<double> &values, bool sorted)
+{
+    fill(values, sorted);
+    cached_ = true;
+    start_ = start;
+    end_ = end;
+}
+
+int Histogram::maxCount() const
+{
+    return counts_.isEmpty() ? 0 : *std::max_element(counts_.constBegin(), counts_.constEnd());
+}
@@ -0,0 +1,130 @@
+/*
+ *  VieSched++ Very Long Baseline Interferometry (VLBI) Scheduling Software
+ *  Copyright (C) 2018  Matthias Schartner
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef HISTOGRAM_H
+#define HISTOGRAM_H
+
+#include <QVector>
+
+/**
+ * @brief histogram with arbitrary bin edges
+ *
+ * Bin i covers [edges[i], edges[i+1]), values below the first or at/above the last edge are counted as underflow
+ * or overflow. Unsorted values are binned with a binary search over the edges, already sorted values with a single
+ * sweep.
+ *
+ * The counts of the last filled time window are kept, so switching between views of the same window does not
+ * collect and bin the values again.
+ */
+class Histogram
+{
+public:
+
+    Histogram();
+
+    /**
+     * @brief histogram with given bin edges
+     *
+     * @param edges ascending bin edges (number of bins + 1)
+     */
+    explicit Histogram(const QVector<double> &edges);
+
+    /**
+     * @brief equally spaced bin edges
+     *
+     * @param first lower edge of first bin
+     * @param width bin width
+     * @param nBins number of bins
+     * @return nBins + 1 edges
+     */
+    static QVector<double> uniformEdges(double first, double width, int nBins);
+
+    /**
+     * @brief change bin edges, the cached counts are dropped
+     *
+     * @param edges ascending bin edges (number of bins + 1)
+     */
+    void setEdges(const QVector<double> &edges);
+
+    const QVector<double> &edges() const{
+        return edges_;
+    }
+
+    int nBins() const{
+        return counts_.size();
+    }
+
+    /**
+     * @brief count values
+     *
+     * @param values values
+     * @param sorted true if values are sorted in ascending order
+     */
+    void fill(const QVector<double> &values, bool sorted = false);
+
+    /**
+     * @brief count values of a time window
+     *
+     * @param start window start time
+     * @param end window end time
+     * @param values values inside the window
+     * @param sorted true if values are sorted in ascending order
+     */
+    void fill(int start, int end, const QVector<double> &values, bool sorted = false);
+
+    /**
+     * @brief check if counts belong to a time window
+     *
+     * @param start window start time
+     * @param end window end time
+     * @return true if fill() was called for this window and the edges did not change since
+     */
+    bool isCached(int start, int end) const{
+        return cached_ && start == start_ && end == end_;
+    }
+
+    const QVector<int> &counts() const{
+        return counts_;
+    }
+
+    int count(int bin) const{
+        return counts_.at(bin);
+    }
+
+    int maxCount() const;
+
+    int underflow() const{
+        return underflow_;
+    }
+
+    int overflow() const{
+        return overflow_;
+    }
+
+private:
+    QVector<double> edges_;         ///< bin edges
+    QVector<int> counts_;           ///< number of values per bin
+    int underflow_;                 ///< number of values below first edge
+    int overflow_;                  ///< number of values at or above last edge
+
+    bool cached_;                   ///< true if counts_ belong to window [start_, end_]
+    int start_;                     ///< window start of counts_
+    int end_;                       ///< window end of counts_
+};
+
+#endif // HISTOGRAM_H
@@ -0,0 +1,119 @@
+/*
+ *  VieSched++ Very Long Baseline Interferometry (VLBI) Scheduling Software
+ *  Copyright (C) 2018  Matthias Schartner
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "intervalwindow.h"
+
+#include <algorithm>
+
+IntervalWindow::IntervalWindow():
+    valid_{false}, start_{0}, end_{0}
+{
+}
+
+void IntervalWindow::build(const QVector<int> &lo, const QVector<int> &hi)
+{
+    lo_ = lo;
+    hi_ = hi;
+
+    // empty intervals are never inside, they are not part of the sorted arrays
+    byLo_.clear();
+    for(int i = 0; i<lo_.size(); ++i){
+        if(lo_[i] <= hi_[i]){
+            byLo_.append(i);
+        }
+    }
+    byHi_ = byLo_;
+    std::sort(byLo_.begin(), byLo_.end(), [this](int a, int b){ return lo_[a] < lo_[b]; });
+    std::sort(byHi_.begin(), byHi_.end(), [this](int a, int b){ return hi_[a] < hi_[b]; });
+
+    int n = byLo_.size();
+    loSorted_.resize(n);
+    hiSorted_.resize(n);
+    for(int i = 0; i<n; ++i){
+        loSorted_[i] = lo_[byLo_[i]];
+        hiSorted_[i] = hi_[byHi_[i]];
+    }
+
+    entered_.clear();
+    left_.clear();
+    valid_ = false;
+}
+
+bool IntervalWindow::setWindow(int start, int end)
+{
+    entered_.resize(0);
+    left_.resize(0);
+
+    if(!valid_){
+        for(int i : byLo_){
+            if(lo_[i] <= end && hi_[i] >= start){
+                entered_.append(i);
+            }
+        }
+        start_ = start;
+        end_ = end;
+        valid_ = true;
+        return true;
+    }
+
+    if(start == start_ && end == end_){
+        return false;
+    }
+
+    // intervals whose lo lies in (endLo, endHi] changed the state of "lo <= end"
+    int endLo = std::min(end_, end);
+    int endHi = std::max(end_, end);
+    auto first = std::upper_bound(loSorted_.constBegin(), loSorted_.constEnd(), endLo);
+    auto last = std::upper_bound(first, loSorted_.constEnd(), endHi);
+    for(auto it = first; it != last; ++it){
+        toggle(byLo_[it - loSorted_.constBegin()], start, end);
+    }
+
+    // intervals whose hi lies in [startLo, startHi) changed the state of "hi >= start"
+    int startLo = std::min(start_, start);
+    int startHi = std::max(start_, start);
+    first = std::lower_bound(hiSorted_.constBegin(), hiSorted_.constEnd(), startLo);
+    last = std::lower_bound(first, hiSorted_.constEnd(), startHi);
+    for(auto it = first; it != last; ++it){
+        int i = byHi_[it - hiSorted_.constBegin()];
+        // already visited in the first loop
+        if(lo_[i] > endLo && lo_[i] <= endHi){
+            continue;
+        }
+        toggle(i, start, end);
+    }
+
+    start_ = start;
+    end_ = end;
+
+    return !entered_.isEmpty() || !left_.isEmpty();
+}
+
+void IntervalWindow::toggle(int i, int start, int end)
+{
+    bool before = lo_[i] <= end_ && hi_[i] >= start_;
+    bool after = lo_[i] <= end && hi_[i] >= start;
+    if(before == after){
+        return;
+    }
+    if(after){
+        entered_.append(i);
+    }else{
+        left_.append(i);
+    }
+}
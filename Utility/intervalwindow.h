@@ -0,0 +1,105 @@
+/*
+ *  VieSched++ Very Long Baseline Interferometry (VLBI) Scheduling Software
+ *  Copyright (C) 2018  Matthias Schartner
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef INTERVALWINDOW_H
+#define INTERVALWINDOW_H
+
+#include <QVector>
+
+/**
+ * @brief intervals which enter or leave a moving time window
+ *
+ * An interval [lo, hi] counts as inside of the window [start, end] if lo <= end and hi >= start (it starts, ends or
+ * lies within the window or covers it). Empty intervals (lo > hi) are never inside.
+ *
+ * The intervals are kept in two arrays, sorted by lo and by hi. If the window changes, only intervals whose lo lies
+ * between the old and new end or whose hi lies between the old and new start can change their state. Both ranges
+ * are found with binary searches, all other intervals are not visited.
+ */
+class IntervalWindow
+{
+public:
+
+    IntervalWindow();
+
+    /**
+     * @brief sort intervals
+     *
+     * The window is invalid afterwards, the next call to setWindow() reports all intervals inside as entered.
+     *
+     * @param lo start of each interval
+     * @param hi end of each interval
+     */
+    void build(const QVector<int> &lo, const QVector<int> &hi);
+
+    /**
+     * @brief move time window
+     *
+     * The intervals which changed their state are available through entered() and left() until the next call.
+     *
+     * @param start window start
+     * @param end window end
+     * @return true if any interval entered or left the window (always true for the first call after build())
+     */
+    bool setWindow(int start, int end);
+
+    bool isValid() const{
+        return valid_;
+    }
+
+    int start() const{
+        return start_;
+    }
+
+    int end() const{
+        return end_;
+    }
+
+    /**
+     * @brief indices of the intervals which entered the window in the last setWindow() call
+     */
+    const QVector<int> &entered() const{
+        return entered_;
+    }
+
+    /**
+     * @brief indices of the intervals which left the window in the last setWindow() call
+     */
+    const QVector<int> &left() const{
+        return left_;
+    }
+
+private:
+    QVector<int> lo_;               ///< start of each interval
+    QVector<int> hi_;               ///< end of each interval
+    QVector<int> byLo_;             ///< non-empty interval indices sorted by lo
+    QVector<int> loSorted_;         ///< lo values in the order of byLo_
+    QVector<int> byHi_;             ///< non-empty interval indices sorted by hi
+    QVector<int> hiSorted_;         ///< hi values in the order of byHi_
+
+    QVector<int> entered_;          ///< intervals which entered the window in the last call
+    QVector<int> left_;             ///< intervals which left the window in the last call
+
+    bool valid_;                    ///< true if a window was set since build()
+    int start_;                     ///< current window start
+    int end_;                       ///< current window end
+
+    void toggle(int i, int start, int end);
+};
+
+#endif // INTERVALWINDOW_H
@@ -0,0 +1,454 @@
+/*
+ *  VieSched++ Very Long Baseline Interferometry (VLBI) Scheduling Software
+ *  Copyright (C) 2018  Matthias Schartner
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "offscreenplot.h"
+
+#include <QFontMetricsF>
+#include <QPainterPath>
+#include <QtMath>
+
+#include <algorithm>
+#include <cmath>
+
+#include "qtutil.h"
+
+OffscreenPlot::SkyCoverage OffscreenPlot::skyCoverage(const VieVS::Scheduler &schedule, int staid)
+{
+    SkyCoverage data;
+    const VieVS::Station &thisSta = schedule.getNetwork().getStation(staid);
+
+    std::pair<std::vector<double>, std::vector<double>> mask = thisSta.getHorizonMask();
+    const std::vector<double> &az = mask.first;
+    const std::vector<double> &el = mask.second;
+    for(int i=0; i<static_cast<int>(az.size()); ++i){
+        data.mask.append(QPointF(az[i]*rad2deg, 90-el[i]*rad2deg));
+    }
+    if(data.mask.isEmpty()){
+        for(int i=0; i<=360; ++i){
+            data.mask.append(QPointF(i, 89));
+        }
+    }
+
+    QList<qtUtil::ObsData> list = qtUtil::getObsData(staid, schedule.getScans());
+    data.points.reserve(list.size());
+    for(const auto &any : list){
+        double az = VieVS::util::wrap2twoPi(any.az)*rad2deg;
+        if(az<0){
+            az+=360;
+        }
+        SkyCoverage::Point p;
+        p.az = az;
+        p.zd = 90-any.el*rad2deg;
+        p.startTime = any.startTime;
+        p.endTime = any.endTime;
+        p.cableWrap = thisSta.getCableWrap().cableWrapFlag(any.az);
+        data.points.append(p);
+    }
+    return data;
+}
+
+OffscreenPlot::UVCoverage OffscreenPlot::uvCoverage(const UVCoverageCache &cache, int srcid, const QVector<double> &scale, bool wavelength)
+{
+    UVCoverage data;
+    const QVector<UVCoverageCache::Point> &points = cache.points(srcid);
+    data.points.reserve(2*points.size()*scale.size());
+
+    double max = 0;
+    for(const UVCoverageCache::Point &p : points){
+        for(double s : scale){
+            double u = p.u * s;
+            double v = p.v * s;
+            max = std::max({max, fabs(u), fabs(v)});
+
+            UVCoverage::Point uv;
+            uv.u = u;
+            uv.v = v;
+            uv.startTime = p.startTime;
+            uv.endTime = p.endTime;
+            data.points.append(uv);
+            uv.u = -u;
+            uv.v = -v;
+            data.points.append(uv);
+        }
+    }
+
+    if(wavelength){
+        data.range = ceil(max/10)*10.0;
+        data.unit = "[10^6 wavelength]";
+    }else{
+        data.range = ceil(max);
+        data.unit = "[1000 km]";
+    }
+    if(data.range == 0){
+        data.range = 1;
+    }
+    return data;
+}
+
+OffscreenPlot::Elevation OffscreenPlot::elevation(const VieVS::Scheduler &schedule, const ElevationTrackCache &cache, int srcid)
+{
+    Elevation data;
+    const std::vector<VieVS::Station> &stations = schedule.getNetwork().getStations();
+    int nsta = stations.size();
+    data.step = cache.step();
+    data.nSamples = cache.samples();
+    data.tracks.resize(nsta*data.nSamples);
+    for(int i=0; i<nsta; ++i){
+        data.stations.append(QString::fromStdString(stations[i].getName()));
+        const float *track = cache.track(srcid, i);
+        std::copy(track, track+data.nSamples, data.tracks.begin() + i*data.nSamples);
+    }
+
+    for(const VieVS::Scan &scan : schedule.getScans()){
+        if(scan.getSourceId() != srcid){
+            continue;
+        }
+        for(int i=0; i<scan.getNSta(); ++i){
+            VieVS::PointingVector s = scan.getPointingVector(i,VieVS::Timestamp::start);
+            VieVS::PointingVector e = scan.getPointingVector(i,VieVS::Timestamp::end);
+
+            Elevation::Segment seg;
+            seg.startTime = s.getTime();
+            seg.endTime = e.getTime();
+            seg.startEl = s.getEl()*rad2deg;
+            seg.endEl = e.getEl()*rad2deg;
+            data.observed.append(seg);
+        }
+    }
+    return data;
+}
+
+QImage OffscreenPlot::renderSkyCoverage(const SkyCoverage &data, int start, int end, const QString &title, const QSize &size)
+{
+    QImage image = newImage(size);
+    QPainter painter(&image);
+    painter.setRenderHint(QPainter::Antialiasing);
+
+    QRectF area = drawTitle(painter, QRectF(QPointF(0,0), size), title);
+    QFontMetricsF fm(painter.font());
+    double radius = std::min(area.width(), area.height())/2 - 1.5*fm.height();
+    if(radius <= 0){
+        return image;
+    }
+    QPointF center = area.center();
+    QRectF circle(center.x()-radius, center.y()-radius, 2*radius, 2*radius);
+
+    // azimuth is measured clockwise from north, radial axis is zenith distance
+    auto toPoint = [&](double az, double zd){
+        double r = zd/90.0*radius;
+        double a = qDegreesToRadians(az);
+        return QPointF(center.x() + r*sin(a), center.y() - r*cos(a));
+    };
+
+    // shades and grid
+    painter.setPen(Qt::NoPen);
+    painter.setBrush(QColor(230, 238, 255));
+    for(int az=0; az<360; az+=60){
+        painter.drawPie(circle, (90-az-30)*16, 30*16);
+    }
+    painter.setBrush(Qt::NoBrush);
+    painter.setPen(QPen(QColor(210, 210, 210), 1));
+    for(int zd=10; zd<90; zd+=10){
+        double r = zd/90.0*radius;
+        painter.drawEllipse(center, r, r);
+    }
+    for(int az=0; az<360; az+=30){
+        painter.drawLine(center, toPoint(az, 90));
+    }
+    painter.setPen(QPen(Qt::black, 1));
+    painter.drawEllipse(circle);
+    for(int az=0; az<360; az+=30){
+        QPointF p = toPoint(az, 90 + 0.75*fm.height()/radius*90);
+        QRectF box(p.x()-fm.height()*1.5, p.y()-fm.height()/2, fm.height()*3, fm.height());
+        painter.drawText(box, Qt::AlignCenter, QString::number(az));
+    }
+
+    // horizon mask, interpolated in azimuth like the polar chart
+    QPolygonF maskLine;
+    for(int i=0; i<data.mask.size(); ++i){
+        const QPointF &cur = data.mask.at(i);
+        if(i>0){
+            const QPointF &prev = data.mask.at(i-1);
+            int n = std::max(1, static_cast<int>(ceil(fabs(cur.x()-prev.x()))));
+            for(int k=1; k<n; ++k){
+                double f = static_cast<double>(k)/n;
+                maskLine.append(toPoint(prev.x() + f*(cur.x()-prev.x()), prev.y() + f*(cur.y()-prev.y())));
+            }
+        }
+        maskLine.append(toPoint(cur.x(), cur.y()));
+    }
+    if(!data.mask.isEmpty()){
+        double first = data.mask.first().x();
+        for(double az = data.mask.last().x(); az > first; az -= 1){
+            maskLine.append(toPoint(az, 90));
+        }
+        maskLine.append(toPoint(first, 90));
+
+        painter.setPen(Qt::NoPen);
+        painter.setBrush(QColor(128, 128, 128, 128));
+        painter.drawPolygon(maskLine);
+    }
+
+    // all scans in gray, scans inside of the window on top colored by cable wrap section
+    painter.setPen(QPen(Qt::darkGray, 1));
+    painter.setBrush(Qt::gray);
+    for(const SkyCoverage::Point &p : data.points){
+        drawMarker(painter, toPoint(p.az, p.zd), 7);
+    }
+    painter.setPen(QPen(Qt::white, 1));
+    for(const SkyCoverage::Point &p : data.points){
+        if(!isInside(p.startTime, p.endTime, start, end)){
+            continue;
+        }
+        switch(p.cableWrap){
+            case VieVS::AbstractCableWrap::CableWrapFlag::n:{
+                painter.setBrush(QColor(77,174,74));
+                break;
+            }
+            case VieVS::AbstractCableWrap::CableWrapFlag::ccw:{
+                painter.setBrush(QColor(228,26,28));
+                break;
+            }
+            case VieVS::AbstractCableWrap::CableWrapFlag::cw:{
+                painter.setBrush(QColor(55,126,184));
+                break;
+            }
+        }
+        drawMarker(painter, toPoint(p.az, p.zd), 15);
+    }
+
+    return image;
+}
+
+QImage OffscreenPlot::renderUVCoverage(const UVCoverage &data, int start, int end, const QString &title, const QSize &size)
+{
+    QImage image = newImage(size);
+    QPainter painter(&image);
+    painter.setRenderHint(QPainter::Antialiasing);
+
+    QRectF area = drawTitle(painter, QRectF(QPointF(0,0), size), title);
+    QFontMetricsF fm(painter.font());
+
+    // square plot area, space for tick labels and axis titles on the left and bottom side
+    double left = fm.width(QString::number(-data.range)) + 2*fm.height();
+    double bottom = 3*fm.height();
+    double side = std::min(area.width() - left - fm.height(), area.height() - bottom - fm.height()/2);
+    if(side <= 0){
+        return image;
+    }
+    double x0 = area.left() + left + (area.width() - left - fm.height() - side)/2;
+    double y0 = area.top() + fm.height()/2;
+    QRectF plot(x0, y0, side, side);
+
+    double range = data.range;
+    auto toPoint = [&](double u, double v){
+        return QPointF(plot.left() + (u+range)/(2*range)*plot.width(), plot.bottom() - (v+range)/(2*range)*plot.height());
+    };
+
+    // grid and axes (five ticks per axis)
+    for(int i=0; i<5; ++i){
+        double val = -range + i*range/2;
+        QPointF px = toPoint(val, -range);
+        QPointF py = toPoint(-range, val);
+
+        painter.setPen(QPen(QColor(210, 210, 210), 1));
+        painter.drawLine(px, toPoint(val, range));
+        painter.drawLine(py, toPoint(range, val));
+
+        painter.setPen(QPen(Qt::black, 1));
+        QString label = QString::number(val);
+        painter.drawText(QRectF(px.x()-fm.width(label), px.y()+fm.height()/4, 2*fm.width(label), fm.height()),
+                         Qt::AlignHCenter | Qt::AlignTop, label);
+        painter.drawText(QRectF(plot.left()-fm.width(label)-fm.height()/2, py.y()-fm.height()/2, fm.width(label), fm.height()),
+                         Qt::AlignRight | Qt::AlignVCenter, label);
+    }
+    painter.drawRect(plot);
+
+    painter.drawText(QRectF(plot.left(), plot.bottom()+1.5*fm.height(), plot.width(), fm.height()),
+                     Qt::AlignCenter, QString("u %1").arg(data.unit));
+    painter.save();
+    painter.translate(plot.left() - left + fm.height()/2, plot.center().y());
+    painter.rotate(-90);
+    painter.drawText(QRectF(-plot.height()/2, -fm.height()/2, plot.height(), fm.height()),
+                     Qt::AlignCenter, QString("v %1").arg(data.unit));
+    painter.restore();
+
+    // all observations in gray, observations inside of the window on top in black
+    painter.setClipRect(plot);
+    painter.setPen(QPen(Qt::gray, 1));
+    painter.setBrush(Qt::gray);
+    for(const UVCoverage::Point &p : data.points){
+        drawMarker(painter, toPoint(p.u, p.v), 4);
+    }
+    painter.setPen(QPen(Qt::black, 1));
+    painter.setBrush(Qt::black);
+    for(const UVCoverage::Point &p : data.points){
+        if(isInside(p.startTime, p.endTime, start, end)){
+            drawMarker(painter, toPoint(p.u, p.v), 4);
+        }
+    }
+
+    return image;
+}
+
+QImage OffscreenPlot::renderElevation(const Elevation &data, const QDateTime &sessionStart, int start, int end,
+                                      const QString &title, const QSize &size)
+{
+    QImage image = newImage(size);
+    QPainter painter(&image);
+    painter.setRenderHint(QPainter::Antialiasing);
+
+    QRectF area = drawTitle(painter, QRectF(QPointF(0,0), size), title);
+    QFontMetricsF fm(painter.font());
+    double h = fm.height();
+
+    // legend below the plot, entries wrap into several rows
+    double sample = 2*h;
+    double spacing = h;
+    QVector<QPointF> legendPos;
+    double x = 0;
+    int rows = 1;
+    for(const QString &name : data.stations){
+        double w = sample + h/2 + fm.width(name);
+        if(x > 0 && x + w > area.width() - 2*h){
+            x = 0;
+            ++rows;
+        }
+        legendPos.append(QPointF(x, (rows-1)*h));
+        x += w + spacing;
+    }
+    double legendHeight = rows*h + h/2;
+
+    double left = fm.width("90") + 2.5*h;
+    QRectF plot(area.left() + left, area.top() + h/2,
+                area.width() - left - 1.5*h, area.height() - h/2 - 2*h - legendHeight);
+    if(plot.width() <= 0 || plot.height() <= 0){
+        return image;
+    }
+
+    if(end <= start){
+        end = start + 1;
+    }
+    auto toPoint = [&](double t, double el){
+        return QPointF(plot.left() + (t-start)/(end-start)*plot.width(), plot.bottom() - el/90.0*plot.height());
+    };
+
+    // grid and axes
+    for(int i=0; i<5; ++i){
+        double el = i*22.5;
+        QPointF p = toPoint(start, el);
+        painter.setPen(QPen(QColor(210, 210, 210), 1));
+        painter.drawLine(p, toPoint(end, el));
+        painter.setPen(QPen(Qt::black, 1));
+        QString label = QString::number(el);
+        painter.drawText(QRectF(plot.left()-fm.width(label)-h/2, p.y()-h/2, fm.width(label), h),
+                         Qt::AlignRight | Qt::AlignVCenter, label);
+    }
+    for(int i=0; i<10; ++i){
+        double t = start + i*(end-start)/9.0;
+        QPointF p = toPoint(t, 0);
+        painter.setPen(QPen(QColor(210, 210, 210), 1));
+        painter.drawLine(p, toPoint(t, 90));
+        painter.setPen(QPen(Qt::black, 1));
+        QString label = sessionStart.addSecs(qRound(t)).toString("hh:mm");
+        painter.drawText(QRectF(p.x()-fm.width(label), p.y()+h/4, 2*fm.width(label), h), Qt::AlignHCenter | Qt::AlignTop, label);
+    }
+    painter.drawRect(plot);
+    painter.save();
+    painter.translate(plot.left() - left + h/2, plot.center().y());
+    painter.rotate(-90);
+    painter.drawText(QRectF(-plot.height()/2, -h/2, plot.height(), h), Qt::AlignCenter, "elevation [deg]");
+    painter.restore();
+
+    // elevation tracks, only samples around the window are drawn
+    painter.save();
+    painter.setClipRect(plot);
+    int k0 = std::max(0, start/data.step - 1);
+    int k1 = std::min(data.nSamples-1, end/data.step + 1);
+    for(int i=0; i<data.stations.size(); ++i){
+        const float *el = data.tracks.constData() + static_cast<size_t>(i)*data.nSamples;
+        QPolygonF line;
+        for(int k=k0; k<=k1; ++k){
+            line.append(toPoint(static_cast<double>(k)*data.step, el[k]));
+        }
+        painter.setPen(QPen(QBrush(stationColor(i)), 1.5, stationPenStyle(i)));
+        painter.drawPolyline(line);
+    }
+    painter.setPen(QPen(QBrush(Qt::black), 4, Qt::SolidLine));
+    for(const Elevation::Segment &seg : data.observed){
+        if(isInside(seg.startTime, seg.endTime, start, end)){
+            painter.drawLine(toPoint(seg.startTime, seg.startEl), toPoint(seg.endTime, seg.endEl));
+        }
+    }
+    painter.restore();
+
+    // legend
+    double legendTop = plot.bottom() + 2*h;
+    for(int i=0; i<data.stations.size(); ++i){
+        QPointF p = legendPos.at(i) + QPointF(area.left() + h, legendTop);
+        painter.setPen(QPen(QBrush(stationColor(i)), 1.5, stationPenStyle(i)));
+        painter.drawLine(QPointF(p.x(), p.y()+h/2), QPointF(p.x()+sample, p.y()+h/2));
+        painter.setPen(QPen(Qt::black, 1));
+        painter.drawText(QRectF(p.x()+sample+h/2, p.y(), fm.width(data.stations.at(i))+1, h),
+                         Qt::AlignLeft | Qt::AlignVCenter, data.stations.at(i));
+    }
+
+    return image;
+}
+
+QImage OffscreenPlot::newImage(const QSize &size)
+{
+    QImage image(size, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::white);
+    return image;
+}
+
+QRectF OffscreenPlot::drawTitle(QPainter &painter, const QRectF &rect, const QString &title)
+{
+    if(title.isEmpty()){
+        return rect;
+    }
+    QFont font = painter.font();
+    QFont bold = font;
+    bold.setBold(true);
+    painter.setFont(bold);
+    double h = QFontMetricsF(bold).height()*1.5;
+    painter.setPen(Qt::black);
+    painter.drawText(QRectF(rect.left(), rect.top(), rect.width(), h), Qt::AlignCenter, title);
+    painter.setFont(font);
+    return rect.adjusted(0, h, 0, 0);
+}
+
+void OffscreenPlot::drawMarker(QPainter &painter, const QPointF &p, double size)
+{
+    painter.drawEllipse(p, size/2, size/2);
+}
+
+QColor OffscreenPlot::stationColor(int i)
+{
+    static const QColor c[9] = {QColor(228,26,28), QColor(55,126,184), QColor(77,175,74),
+                                QColor(152,78,163), QColor(255,127,0), QColor(255,255,51),
+                                QColor(166,86,40), QColor(247,129,191), QColor(153,153,153)};
+    return c[i%9];
+}
+
+Qt::PenStyle OffscreenPlot::stationPenStyle(int i)
+{
+    static const Qt::PenStyle s[5] = {Qt::SolidLine, Qt::DashLine, Qt::DotLine, Qt::DashDotLine, Qt::DashDotDotLine};
+    return s[(i/9)%5];
+}
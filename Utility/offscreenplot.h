@@ -0,0 +1,215 @@
+/*
+ *  VieSched++ Very Long Baseline Interferometry (VLBI) Scheduling Software
+ *  Copyright (C) 2018  Matthias Schartner
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OFFSCREENPLOT_H
+#define OFFSCREENPLOT_H
+
+#include <QDateTime>
+#include <QImage>
+#include <QPainter>
+#include <QPolygonF>
+#include <QString>
+#include <QVector>
+
+#include "../VieSchedpp/Scheduler.h"
+#include "uvcoveragecache.h"
+#include "elevationtrackcache.h"
+
+/**
+ * @brief offscreen rendering of analyser plots
+ *
+ * The plot data is extracted once from the schedule and the caches (GUI thread). Afterwards, the render functions
+ * only read these plain data structures and paint into a new QImage, so any number of images can be rendered and
+ * saved concurrently in worker threads without touching the charts of the analyser.
+ *
+ * The images follow the look of the corresponding analyser charts.
+ */
+class OffscreenPlot
+{
+public:
+
+    /**
+     * @brief sky coverage of one station
+     */
+    struct SkyCoverage{
+        /**
+         * @brief pointing of one scan
+         */
+        struct Point{
+            double az;              ///< azimuth [deg]
+            double zd;              ///< zenith distance [deg]
+            int startTime;          ///< scan start
+            int endTime;            ///< scan end
+            VieVS::AbstractCableWrap::CableWrapFlag cableWrap; ///< cable wrap section
+        };
+
+        QPolygonF mask;             ///< horizon mask as (azimuth [deg], zenith distance [deg])
+        QVector<Point> points;      ///< pointings of all scans
+    };
+
+    /**
+     * @brief uv coverage of one source
+     */
+    struct UVCoverage{
+        /**
+         * @brief uv coordinate of one observation
+         */
+        struct Point{
+            double u;               ///< u coordinate
+            double v;               ///< v coordinate
+            int startTime;          ///< observation start
+            int endTime;            ///< observation end
+        };
+
+        QString unit;               ///< unit of u and v (axis title)
+        double range;               ///< axis range (-range to range)
+        QVector<Point> points;      ///< uv coordinates including mirrored points
+    };
+
+    /**
+     * @brief elevation of one source at all stations
+     */
+    struct Elevation{
+        /**
+         * @brief observed part of the elevation track
+         */
+        struct Segment{
+            int startTime;          ///< start of observation
+            int endTime;            ///< end of observation
+            double startEl;         ///< elevation at start [deg]
+            double endEl;           ///< elevation at end [deg]
+        };
+
+        QVector<QString> stations;  ///< station names
+        int step;                   ///< time between samples in seconds
+        int nSamples;               ///< number of samples per station
+        QVector<float> tracks;      ///< elevations [deg] (station, sample)
+        QVector<Segment> observed;  ///< observed segments of all stations
+    };
+
+    /**
+     * @brief one image of a batch export
+     */
+    struct Job{
+        int item;                   ///< index of plot data
+        int startTime;              ///< window start
+        int endTime;                ///< window end
+        QString title;              ///< plot title
+        QString fileName;           ///< output file
+        bool saved;                 ///< true if image was written
+    };
+
+    /**
+     * @brief extract sky coverage of a station
+     *
+     * @param schedule schedule
+     * @param staid station id
+     * @return sky coverage
+     */
+    static SkyCoverage skyCoverage(const VieVS::Scheduler &schedule, int staid);
+
+    /**
+     * @brief extract uv coverage of a source
+     *
+     * Every cached uv coordinate is scaled once per entry of scale.
+     *
+     * @param cache uv coverage cache
+     * @param srcid source id
+     * @param scale scale factors from [m] to plot unit (one per frequency)
+     * @param wavelength true if u and v are given in wavelength, false if they are in [1000 km]
+     * @return uv coverage
+     */
+    static UVCoverage uvCoverage(const UVCoverageCache &cache, int srcid, const QVector<double> &scale, bool wavelength);
+
+    /**
+     * @brief extract elevation tracks of a source
+     *
+     * @param schedule schedule
+     * @param cache elevation track cache
+     * @param srcid source id
+     * @return elevation tracks
+     */
+    static Elevation elevation(const VieVS::Scheduler &schedule, const ElevationTrackCache &cache, int srcid);
+
+    /**
+     * @brief render sky coverage
+     *
+     * @param data sky coverage
+     * @param start window start
+     * @param end window end
+     * @param title plot title
+     * @param size image size
+     * @return image
+     */
+    static QImage renderSkyCoverage(const SkyCoverage &data, int start, int end, const QString &title, const QSize &size);
+
+    /**
+     * @brief render uv coverage
+     *
+     * @param data uv coverage
+     * @param start window start
+     * @param end window end
+     * @param title plot title
+     * @param size image size
+     * @return image
+     */
+    static QImage renderUVCoverage(const UVCoverage &data, int start, int end, const QString &title, const QSize &size);
+
+    /**
+     * @brief render elevation tracks
+     *
+     * The time axis spans the window.
+     *
+     * @param data elevation tracks
+     * @param sessionStart session start (time axis labels)
+     * @param start window start
+     * @param end window end
+     * @param title plot title
+     * @param size image size
+     * @return image
+     */
+    static QImage renderElevation(const Elevation &data, const QDateTime &sessionStart, int start, int end,
+                                  const QString &title, const QSize &size);
+
+    /**
+     * @brief check if an interval is (partly) inside of the window
+     *
+     * @param startTime interval start
+     * @param endTime interval end
+     * @param start window start
+     * @param end window end
+     * @return true if interval and window overlap
+     */
+    static bool isInside(int startTime, int endTime, int start, int end){
+        return startTime <= end && endTime >= start;
+    }
+
+private:
+
+    static QImage newImage(const QSize &size);
+
+    static QRectF drawTitle(QPainter &painter, const QRectF &rect, const QString &title);
+
+    static void drawMarker(QPainter &painter, const QPointF &p, double size);
+
+    static QColor stationColor(int i);
+
+    static Qt::PenStyle stationPenStyle(int i);
+};
+
+#endif // OFFSCREENPLOT_H
@@ -0,0 +1,188 @@
+/*
+ *  VieSched++ Very Long Baseline Interferometry (VLBI) Scheduling Software
+ *  Copyright (C) 2018  Matthias Schartner
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "pointindex.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+PointIndex::PointIndex():
+    x0_{0}, y0_{0}, cellSize_{1}, nx_{0}, ny_{0}
+{
+}
+
+void PointIndex::build(const QVector<QPointF> &points)
+{
+    points_ = points;
+    int n = points_.size();
+    if(n == 0){
+        clear();
+        return;
+    }
+
+    double xmin = points_[0].x();
+    double xmax = xmin;
+    double ymin = points_[0].y();
+    double ymax = ymin;
+    for(const QPointF &p : points_){
+        xmin = std::min(xmin, p.x());
+        xmax = std::max(xmax, p.x());
+        ymin = std::min(ymin, p.y());
+        ymax = std::max(ymax, p.y());
+    }
+    double w = xmax-xmin;
+    double h = ymax-ymin;
+
+    // about one point per cell, at most 1024 cells per direction
+    double area = std::max(w, h) * std::max(std::min(w, h), std::max(w, h)/n);
+    cellSize_ = std::sqrt(area/n);
+    if(!(cellSize_ > 0)){
+        cellSize_ = 1;
+    }
+    cellSize_ = std::max({cellSize_, w/1024, h/1024});
+    x0_ = xmin;
+    y0_ = ymin;
+    nx_ = static_cast<int>(w/cellSize_) + 1;
+    ny_ = static_cast<int>(h/cellSize_) + 1;
+
+    // counting sort of point ids by cell
+    QVector<int> cell(n);
+    cellStart_.fill(0, nx_*ny_+1);
+    for(int i=0; i<n; ++i){
+        cell[i] = cellY(points_[i].y())*nx_ + cellX(points_[i].x());
+        ++cellStart_[cell[i]+1];
+    }
+    for(int c=0; c<nx_*ny_; ++c){
+        cellStart_[c+1] += cellStart_[c];
+    }
+    cellItems_.resize(n);
+    QVector<int> next = cellStart_;
+    for(int i=0; i<n; ++i){
+        cellItems_[next[cell[i]]++] = i;
+    }
+}
+
+void PointIndex::clear()
+{
+    points_.clear();
+    cellStart_.clear();
+    cellItems_.clear();
+    x0_ = 0;
+    y0_ = 0;
+    cellSize_ = 1;
+    nx_ = 0;
+    ny_ = 0;
+}
+
+int PointIndex::nearest(const QPointF &p, double maxDistance) const
+{
+    if(points_.isEmpty()){
+        return -1;
+    }
+
+    int best = -1;
+    double bestD2 = maxDistance < 0 ? std::numeric_limits<double>::infinity() : maxDistance*maxDistance;
+    int cx = cellX(p.x());
+    int cy = cellY(p.y());
+    int maxRing = std::max(nx_, ny_);
+
+    // visit cells ring by ring around the cell of the query position. All points in ring k are at least (k-1) cells
+    // away from the query position (also if it lies outside of the grid), so the search stops as soon as this lower
+    // bound exceeds the best distance
+    for(int ring=0; ring<=maxRing; ++ring){
+        if(ring > 1){
+            double bound = (ring-1)*cellSize_;
+            if(bound*bound > bestD2){
+                break;
+            }
+        }
+        if(ring == 0){
+            visitCell(cx, cy, p, best, bestD2);
+            continue;
+        }
+        for(int x=cx-ring; x<=cx+ring; ++x){
+            visitCell(x, cy-ring, p, best, bestD2);
+            visitCell(x, cy+ring, p, best, bestD2);
+        }
+        for(int y=cy-ring+1; y<=cy+ring-1; ++y){
+            visitCell(cx-ring, y, p, best, bestD2);
+            visitCell(cx+ring, y, p, best, bestD2);
+        }
+    }
+    return best;
+}
+
+QVector<int> PointIndex::within(const QPointF &p, double radius) const
+{
+    QVector<int> ids;
+    if(points_.isEmpty() || radius < 0){
+        return ids;
+    }
+
+    double r2 = radius*radius;
+    int x1 = cellX(p.x()-radius);
+    int x2 = cellX(p.x()+radius);
+    int y1 = cellY(p.y()-radius);
+    int y2 = cellY(p.y()+radius);
+    for(int cy=y1; cy<=y2; ++cy){
+        for(int cx=x1; cx<=x2; ++cx){
+            int c = cy*nx_ + cx;
+            for(int k=cellStart_[c]; k<cellStart_[c+1]; ++k){
+                int id = cellItems_[k];
+                double dx = points_[id].x()-p.x();
+                double dy = points_[id].y()-p.y();
+                if(dx*dx+dy*dy <= r2){
+                    ids.append(id);
+                }
+            }
+        }
+    }
+    std::sort(ids.begin(), ids.end());
+    return ids;
+}
+
+int PointIndex::cellX(double x) const
+{
+    double c = std::floor((x-x0_)/cellSize_);
+    return static_cast<int>(std::max(0.0, std::min(c, static_cast<double>(nx_-1))));
+}
+
+int PointIndex::cellY(double y) const
+{
+    double c = std::floor((y-y0_)/cellSize_);
+    return static_cast<int>(std::max(0.0, std::min(c, static_cast<double>(ny_-1))));
+}
+
+void PointIndex::visitCell(int cx, int cy, const QPointF &p, int &best, double &bestD2) const
+{
+    if(cx < 0 || cy < 0 || cx >= nx_ || cy >= ny_){
+        return;
+    }
+    int c = cy*nx_ + cx;
+    for(int k=cellStart_[c]; k<cellStart_[c+1]; ++k){
+        int id = cellItems_[k];
+        double dx = points_[id].x()-p.x();
+        double dy = points_[id].y()-p.y();
+        double d2 = dx*dx+dy*dy;
+        if(d2 < bestD2 || (d2 == bestD2 && (best == -1 || id < best))){
+            best = id;
+            bestD2 = d2;
+        }
+    }
+}
@@ -0,0 +1,96 @@
+/*
+ *  VieSched++ Very Long Baseline Interferometry (VLBI) Scheduling Software
+ *  Copyright (C) 2018  Matthias Schartner
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef POINTINDEX_H
+#define POINTINDEX_H
+
+#include <QPointF>
+#include <QVector>
+
+/**
+ * @brief uniform grid over projected marker positions
+ *
+ * The bounding box of all points is divided into square cells with on average about one point per cell. The point
+ * ids of each cell are stored contiguously (sorted by cell), so a lookup only visits the few cells around the query
+ * position instead of all points.
+ *
+ * The positions are stored as well and can be used to place markers without projecting again.
+ */
+class PointIndex
+{
+public:
+
+    PointIndex();
+
+    /**
+     * @brief build index
+     *
+     * @param points projected positions, the index of a point is its id
+     */
+    void build(const QVector<QPointF> &points);
+
+    void clear();
+
+    int size() const{
+        return points_.size();
+    }
+
+    const QPointF &point(int id) const{
+        return points_.at(id);
+    }
+
+    const QVector<QPointF> &points() const{
+        return points_;
+    }
+
+    /**
+     * @brief nearest point
+     *
+     * @param p query position
+     * @param maxDistance maximum distance (negative for unlimited)
+     * @return id of nearest point (smallest id if several have the same distance) or -1 if there is none in range
+     */
+    int nearest(const QPointF &p, double maxDistance = -1) const;
+
+    /**
+     * @brief all points within a radius
+     *
+     * @param p query position
+     * @param radius search radius
+     * @return ids of all points within radius in ascending order
+     */
+    QVector<int> within(const QPointF &p, double radius) const;
+
+private:
+    QVector<QPointF> points_;       ///< positions
+    QVector<int> cellStart_;        ///< offset of each cell in cellItems_ (nx_*ny_+1 entries)
+    QVector<int> cellItems_;        ///< point ids sorted by cell
+    double x0_;                     ///< left border of grid
+    double y0_;                     ///< bottom border of grid
+    double cellSize_;               ///< cell width and height
+    int nx_;                        ///< number of cells in x direction
+    int ny_;                        ///< number of cells in y direction
+
+    int cellX(double x) const;
+
+    int cellY(double y) const;
+
+    void visitCell(int cx, int cy, const QPointF &p, int &best, double &bestD2) const;
+};
+
+#endif // POINTINDEX_H
@@ -0,0 +1,134 @@
+/*
+ *  VieSched++ Very Long Baseline Interferometry (VLBI) Scheduling Software
+ *  Copyright (C) 2018  Matthias Schartner
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "polarheatmap.h"
+
+#include <QLineF>
+#include <QtMath>
+
+PolarHeatmap::PolarHeatmap(QChart *chart):
+    QGraphicsObject(chart), chart_{chart}, dirty_{true}
+{
+    // above axis shades, below grid and series
+    setZValue(1.5);
+    connect(chart_, SIGNAL(plotAreaChanged(QRectF)), this, SLOT(updateGeometry()));
+}
+
+void PolarHeatmap::setPointings(const QVector<SkyCoverageRaster::Pointing> &pointings)
+{
+    raster_.build(pointings);
+    updateGeometry();
+}
+
+void PolarHeatmap::setWindow(int start, int end)
+{
+    if(raster_.setWindow(start, end)){
+        dirty_ = true;
+        update();
+    }
+}
+
+QRectF PolarHeatmap::boundingRect() const
+{
+    return rect_;
+}
+
+void PolarHeatmap::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget)
+{
+    Q_UNUSED(option)
+    Q_UNUSED(widget)
+
+    if(dirty_){
+        colorize();
+    }
+    if(!image_.isNull()){
+        painter->drawImage(rect_, image_);
+    }
+}
+
+void PolarHeatmap::updateGeometry()
+{
+    prepareGeometryChange();
+    rect_ = QRectF();
+    pixelBin_.clear();
+    image_ = QImage();
+    dirty_ = true;
+
+    if(chart_->series().isEmpty()){
+        return;
+    }
+    QPointF center = chart_->mapToPosition(QPointF(0, 0));
+    double radius = QLineF(center, chart_->mapToPosition(QPointF(0, 90))).length();
+    int size = qCeil(2*radius);
+    if(size < 2){
+        return;
+    }
+    rect_ = QRectF(center.x()-size/2., center.y()-size/2., size, size);
+
+    pixelBin_.resize(size*size);
+    double c = size/2.;
+    for(int y = 0; y<size; ++y){
+        for(int x = 0; x<size; ++x){
+            double dx = x + 0.5 - c;
+            double dy = y + 0.5 - c;
+            double zd = qSqrt(dx*dx + dy*dy)/radius*90.;
+            if(zd > 90){
+                pixelBin_[y*size+x] = -1;
+            }else{
+                // azimuth is measured clockwise from north (top)
+                double az = qRadiansToDegrees(qAtan2(dx, -dy));
+                pixelBin_[y*size+x] = raster_.bin(az, zd);
+            }
+        }
+    }
+    image_ = QImage(size, size, QImage::Format_ARGB32);
+    update();
+}
+
+void PolarHeatmap::colorize()
+{
+    dirty_ = false;
+    if(image_.isNull()){
+        return;
+    }
+    image_.fill(Qt::transparent);
+
+    int max = raster_.maxCount();
+    if(max == 0){
+        return;
+    }
+
+    // blue (few pointings) to red (many pointings)
+    QVector<QRgb> colors(max+1);
+    colors[0] = qRgba(0, 0, 0, 0);
+    for(int i = 1; i<=max; ++i){
+        double t = max == 1 ? 1. : static_cast<double>(i-1)/(max-1);
+        colors[i] = QColor::fromHsvF(0.66*(1-t), 1., 1., 0.85).rgba();
+    }
+
+    int size = image_.width();
+    for(int y = 0; y<size; ++y){
+        QRgb *line = reinterpret_cast<QRgb *>(image_.scanLine(y));
+        const int *bins = pixelBin_.constData() + y*size;
+        for(int x = 0; x<size; ++x){
+            if(bins[x] >= 0){
+                line[x] = colors[raster_.count(bins[x])];
+            }
+        }
+    }
+}
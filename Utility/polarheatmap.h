@@ -0,0 +1,88 @@
+/*
+ *  VieSched++ Very Long Baseline Interferometry (VLBI) Scheduling Software
+ *  Copyright (C) 2018  Matthias Schartner
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef POLARHEATMAP_H
+#define POLARHEATMAP_H
+
+#include <QtCharts/QChart>
+#include <QGraphicsObject>
+#include <QImage>
+#include <QPainter>
+
+#include "Utility/skycoverageraster.h"
+
+QT_CHARTS_USE_NAMESPACE
+
+/**
+ * @brief sky coverage raster drawn as one image on a polar chart
+ *
+ * The chart must use the layout of the sky coverage plots: azimuth 0-360 deg on the angular axis (north on top,
+ * clockwise) and zenith distance 0-90 deg on the radial axis.
+ *
+ * The bin of every pixel is computed once whenever the plot area changes. Moving the time window only updates the
+ * counts of the raster and recolors the image.
+ */
+class PolarHeatmap : public QGraphicsObject
+{
+    Q_OBJECT
+public:
+
+    PolarHeatmap(QChart *chart);
+
+    /**
+     * @brief set pointings of displayed station
+     *
+     * @param pointings all pointings of the station
+     */
+    void setPointings(const QVector<SkyCoverageRaster::Pointing> &pointings);
+
+    /**
+     * @brief move time window
+     *
+     * @param start window start time in seconds since session start
+     * @param end window end time in seconds since session start
+     */
+    void setWindow(int start, int end);
+
+    const SkyCoverageRaster &raster() const{
+        return raster_;
+    }
+
+    QRectF boundingRect() const;
+
+    void paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget);
+
+public slots:
+
+    /**
+     * @brief recompute bin of each pixel after the plot area changed
+     */
+    void updateGeometry();
+
+private:
+    QChart *chart_;
+    SkyCoverageRaster raster_;
+    QRectF rect_;                   ///< bounding square of the polar plot area
+    QVector<int> pixelBin_;         ///< bin of each pixel (-1 outside of plot area)
+    QImage image_;                  ///< colored raster
+    bool dirty_;                    ///< true if image_ does not match raster_
+
+    void colorize();
+};
+
+#endif // POLARHEATMAP_H
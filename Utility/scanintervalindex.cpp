@@ -0,0 +1,178 @@
+/*
+ *  VieSched++ Very Long Baseline Interferometry (VLBI) Scheduling Software
+ *  Copyright (C) 2018  Matthias Schartner
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "scanintervalindex.h"
+
+#include <algorithm>
+
+ScanIntervalIndex::ScanIntervalIndex():
+    offsetStationScans_{0}, offsetStationObs_{0}, offsetSourceScans_{0}, offsetSourceObs_{0}, offsetBaselineObs_{0},
+    nsta_{0}, nsrc_{0}, nbl_{0}
+{
+}
+
+void ScanIntervalIndex::build(const VieVS::Scheduler &schedule)
+{
+    nsta_ = schedule.getNetwork().getNSta();
+    nsrc_ = schedule.getSources().size();
+    nbl_ = schedule.getNetwork().getNBls();
+
+    offsetStationScans_ = 0;
+    offsetStationObs_ = offsetStationScans_ + nsta_;
+    offsetSourceScans_ = offsetStationObs_ + nsta_;
+    offsetSourceObs_ = offsetSourceScans_ + nsrc_;
+    offsetBaselineObs_ = offsetSourceObs_ + nsrc_;
+    int nCounter = offsetBaselineObs_ + nbl_;
+
+    items_.clear();
+    for(const VieVS::Scan &scan : schedule.getScans()){
+        int scanStart = scan.getTimes().getObservingTime(VieVS::Timestamp::start);
+        int scanEnd = scan.getTimes().getObservingTime(VieVS::Timestamp::end);
+        int srcid = scan.getSourceId();
+
+        addItem(scanStart, scanEnd, offsetSourceScans_ + srcid);
+
+        for(int i = 0; i<scan.getNSta(); ++i){
+            int pvStart = scan.getPointingVector(i,VieVS::Timestamp::start).getTime();
+            int pvEnd = scan.getPointingVector(i,VieVS::Timestamp::end).getTime();
+            int staid = scan.getPointingVector(i).getStaid();
+
+            addItem(std::max(pvStart, scanStart), std::min(pvEnd, scanEnd), offsetStationScans_ + staid);
+        }
+        for(int i = 0; i<scan.getNObs(); ++i){
+            const VieVS::Observation &obs = scan.getObservation(i);
+            int obsStart = obs.getStartTime();
+            int obsEnd = obs.getStartTime() + obs.getObservingTime();
+
+            addItem(std::max(obsStart, scanStart), std::min(obsEnd, scanEnd),
+                    offsetStationObs_ + obs.getStaid1(), offsetStationObs_ + obs.getStaid2(),
+                    offsetSourceObs_ + srcid, offsetBaselineObs_ + obs.getBlid());
+        }
+    }
+
+    int n = items_.size();
+    QVector<int> lo(n);
+    QVector<int> hi(n);
+    for(int i = 0; i<n; ++i){
+        lo[i] = items_[i].lo;
+        hi[i] = items_[i].hi;
+    }
+    window_.build(lo, hi);
+
+    counts_.fill(0, nCounter);
+    stationChanged_.fill(0, nsta_);
+    sourceChanged_.fill(0, nsrc_);
+    baselineChanged_.fill(0, nbl_);
+    changedStations_.clear();
+    changedSources_.clear();
+    changedBaselines_.clear();
+}
+
+bool ScanIntervalIndex::setWindow(int start, int end)
+{
+    bool first = !window_.isValid();
+    if(!window_.setWindow(start, end)){
+        return false;
+    }
+
+    if(first){
+        counts_.fill(0);
+    }
+    for(int i : window_.entered()){
+        count(items_[i], 1);
+    }
+    for(int i : window_.left()){
+        count(items_[i], -1);
+    }
+
+    if(first){
+        for(int i = 0; i<nsta_; ++i){
+            mark(stationChanged_, changedStations_, i);
+        }
+        for(int i = 0; i<nsrc_; ++i){
+            mark(sourceChanged_, changedSources_, i);
+        }
+        for(int i = 0; i<nbl_; ++i){
+            mark(baselineChanged_, changedBaselines_, i);
+        }
+    }
+    return true;
+}
+
+void ScanIntervalIndex::clearChanged()
+{
+    for(int i : changedStations_){
+        stationChanged_[i] = 0;
+    }
+    for(int i : changedSources_){
+        sourceChanged_[i] = 0;
+    }
+    for(int i : changedBaselines_){
+        baselineChanged_[i] = 0;
+    }
+    changedStations_.clear();
+    changedSources_.clear();
+    changedBaselines_.clear();
+}
+
+void ScanIntervalIndex::addItem(int lo, int hi, int c0, int c1, int c2, int c3)
+{
+    // pointing vectors and observations are clipped to their scan, an interval which lies completely outside of the
+    // scan becomes empty (lo > hi), IntervalWindow never reports it as inside
+    Item item;
+    item.lo = lo;
+    item.hi = hi;
+    item.counter[0] = c0;
+    item.counter[1] = c1;
+    item.counter[2] = c2;
+    item.counter[3] = c3;
+    items_.append(item);
+}
+
+void ScanIntervalIndex::count(const Item &item, int delta)
+{
+    for(int c : item.counter){
+        if(c >= 0){
+            counts_[c] += delta;
+            markChanged(c);
+        }
+    }
+}
+
+void ScanIntervalIndex::markChanged(int counter)
+{
+    if(counter < offsetStationObs_){
+        mark(stationChanged_, changedStations_, counter - offsetStationScans_);
+    }else if(counter < offsetSourceScans_){
+        mark(stationChanged_, changedStations_, counter - offsetStationObs_);
+    }else if(counter < offsetSourceObs_){
+        mark(sourceChanged_, changedSources_, counter - offsetSourceScans_);
+    }else if(counter < offsetBaselineObs_){
+        mark(sourceChanged_, changedSources_, counter - offsetSourceObs_);
+    }else{
+        mark(baselineChanged_, changedBaselines_, counter - offsetBaselineObs_);
+    }
+}
+
+void ScanIntervalIndex::mark(QVector<char> &flags, QVector<int> &ids, int id)
+{
+    if(!flags[id]){
+        flags[id] = 1;
+        ids.append(id);
+    }
+}
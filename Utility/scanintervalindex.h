@@ -0,0 +1,156 @@
+/*
+ *  VieSched++ Very Long Baseline Interferometry (VLBI) Scheduling Software
+ *  Copyright (C) 2018  Matthias Schartner
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SCANINTERVALINDEX_H
+#define SCANINTERVALINDEX_H
+
+#include <QVector>
+
+#include "../VieSchedpp/Scheduler.h"
+#include "intervalwindow.h"
+
+/**
+ * @brief number of scans and observations per station, source and baseline inside a time window
+ *
+ * Every scan, pointing vector and observation of a schedule is stored once as an interval [lo, hi]. An interval
+ * counts as inside of the window [start, end] if lo <= end and hi >= start (it starts, ends or lies within the
+ * window or covers it). Pointing vectors and observations only count if their scan counts as well, therefore their
+ * interval is intersected with the interval of the scan.
+ *
+ * Only the intervals which enter or leave the window are visited if it moves (see IntervalWindow).
+ */
+class ScanIntervalIndex
+{
+public:
+
+    ScanIntervalIndex();
+
+    /**
+     * @brief build intervals from schedule
+     *
+     * The window is invalid afterwards, the next call to setWindow() counts all intervals.
+     *
+     * @param schedule schedule
+     */
+    void build(const VieVS::Scheduler &schedule);
+
+    /**
+     * @brief move time window
+     *
+     * The ids whose counts changed are added to changedStations(), changedSources() and changedBaselines(). They
+     * accumulate over several calls until clearChanged() is called. After build(), all ids are reported as changed.
+     *
+     * Does not touch the schedule, it can be called from a worker thread as long as the index is not accessed
+     * concurrently.
+     *
+     * @param start window start time in seconds since session start
+     * @param end window end time in seconds since session start
+     * @return true if any count changed
+     */
+    bool setWindow(int start, int end);
+
+    /**
+     * @brief reset list of changed ids
+     */
+    void clearChanged();
+
+    bool isValid() const{
+        return window_.isValid();
+    }
+
+    int windowStart() const{
+        return window_.start();
+    }
+
+    int windowEnd() const{
+        return window_.end();
+    }
+
+    int stationScans(int staid) const{
+        return counts_[offsetStationScans_ + staid];
+    }
+
+    int stationObs(int staid) const{
+        return counts_[offsetStationObs_ + staid];
+    }
+
+    int sourceScans(int srcid) const{
+        return counts_[offsetSourceScans_ + srcid];
+    }
+
+    int sourceObs(int srcid) const{
+        return counts_[offsetSourceObs_ + srcid];
+    }
+
+    int baselineObs(int blid) const{
+        return counts_[offsetBaselineObs_ + blid];
+    }
+
+    const QVector<int> &changedStations() const{
+        return changedStations_;
+    }
+
+    const QVector<int> &changedSources() const{
+        return changedSources_;
+    }
+
+    const QVector<int> &changedBaselines() const{
+        return changedBaselines_;
+    }
+
+private:
+    /**
+     * @brief scan, pointing vector or observation
+     */
+    struct Item{
+        int lo;                     ///< interval start
+        int hi;                     ///< interval end
+        int counter[4];             ///< counters which are incremented if the interval is inside (-1 if unused)
+    };
+
+    QVector<Item> items_;           ///< all intervals
+    IntervalWindow window_;         ///< items inside the current window
+
+    QVector<int> counts_;           ///< counters of all types
+    int offsetStationScans_;
+    int offsetStationObs_;
+    int offsetSourceScans_;
+    int offsetSourceObs_;
+    int offsetBaselineObs_;
+
+    int nsta_;
+    int nsrc_;
+    int nbl_;
+
+    QVector<char> stationChanged_;  ///< changed flag per station
+    QVector<char> sourceChanged_;   ///< changed flag per source
+    QVector<char> baselineChanged_; ///< changed flag per baseline
+    QVector<int> changedStations_;
+    QVector<int> changedSources_;
+    QVector<int> changedBaselines_;
+
+    void addItem(int lo, int hi, int c0, int c1 = -1, int c2 = -1, int c3 = -1);
+
+    void count(const Item &item, int delta);
+
+    void markChanged(int counter);
+
+    static void mark(QVector<char> &flags, QVector<int> &ids, int id);
+};
+
+#endif // SCANINTERVALINDEX_H
@@ -0,0 +1,87 @@
+/*
+ *  VieSched++ Very Long Baseline Interferometry (VLBI) Scheduling Software
+ *  Copyright (C) 2018  Matthias Schartner
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "skycoverageraster.h"
+
+#include <algorithm>
+#include <cmath>
+
+SkyCoverageRaster::SkyCoverageRaster():
+    binSize_{1}, nAz_{360}, nZd_{90}, total_{0}
+{
+    counts_.fill(0, nAz_*nZd_);
+}
+
+void SkyCoverageRaster::build(const QVector<Pointing> &pointings, double binSize)
+{
+    binSize_ = binSize > 0 ? binSize : 1.0;
+    nAz_ = static_cast<int>(std::ceil(360./binSize_ - 1e-9));
+    nZd_ = static_cast<int>(std::ceil(90./binSize_ - 1e-9));
+
+    int n = pointings.size();
+    bin_.resize(n);
+    QVector<int> lo(n);
+    QVector<int> hi(n);
+    for(int i = 0; i<n; ++i){
+        bin_[i] = bin(pointings[i].az, pointings[i].zd);
+        lo[i] = pointings[i].startTime;
+        hi[i] = pointings[i].endTime;
+    }
+    window_.build(lo, hi);
+
+    counts_.fill(0, nAz_*nZd_);
+    total_ = 0;
+}
+
+bool SkyCoverageRaster::setWindow(int start, int end)
+{
+    bool first = !window_.isValid();
+    if(!window_.setWindow(start, end)){
+        return false;
+    }
+
+    if(first){
+        counts_.fill(0);
+        total_ = 0;
+    }
+    for(int i : window_.entered()){
+        ++counts_[bin_[i]];
+    }
+    for(int i : window_.left()){
+        --counts_[bin_[i]];
+    }
+    total_ += window_.entered().size() - window_.left().size();
+
+    return true;
+}
+
+int SkyCoverageRaster::bin(double az, double zd) const
+{
+    az = std::fmod(az, 360.);
+    if(az < 0){
+        az += 360.;
+    }
+    int iaz = std::min(static_cast<int>(az/binSize_), nAz_-1);
+    int izd = std::max(0, std::min(static_cast<int>(zd/binSize_), nZd_-1));
+    return izd*nAz_ + iaz;
+}
+
+int SkyCoverageRaster::maxCount() const
+{
+    return counts_.isEmpty() ? 0 : *std::max_element(counts_.constBegin(), counts_.constEnd());
+}
@@ -0,0 +1,120 @@
+/*
+ *  VieSched++ Very Long Baseline Interferometry (VLBI) Scheduling Software
+ *  Copyright (C) 2018  Matthias Schartner
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SKYCOVERAGERASTER_H
+#define SKYCOVERAGERASTER_H
+
+#include <QVector>
+
+#include "intervalwindow.h"
+
+/**
+ * @brief number of pointings per azimuth/zenith distance bin inside a time window
+ *
+ * Each pointing of a station is assigned to one bin of a regular az/zd raster (1 deg x 1 deg by default). A pointing
+ * counts as inside of the window [start, end] if startTime <= end and endTime >= start, the same rule as in
+ * ScanIntervalIndex.
+ *
+ * If the window changes, only the pointings which enter or leave it are added to or removed from their bin (see
+ * IntervalWindow).
+ */
+class SkyCoverageRaster
+{
+public:
+
+    /**
+     * @brief pointing of a station
+     */
+    struct Pointing{
+        double az;                  ///< azimuth in degrees [0, 360)
+        double zd;                  ///< zenith distance in degrees [0, 90]
+        int startTime;              ///< start time in seconds since session start
+        int endTime;                ///< end time in seconds since session start
+    };
+
+    SkyCoverageRaster();
+
+    /**
+     * @brief assign pointings to bins
+     *
+     * The window is invalid afterwards, the next call to setWindow() counts all pointings.
+     *
+     * @param pointings all pointings of a station
+     * @param binSize bin width and height in degrees
+     */
+    void build(const QVector<Pointing> &pointings, double binSize = 1.0);
+
+    /**
+     * @brief move time window
+     *
+     * @param start window start time in seconds since session start
+     * @param end window end time in seconds since session start
+     * @return true if any count changed
+     */
+    bool setWindow(int start, int end);
+
+    double binSize() const{
+        return binSize_;
+    }
+
+    int nAz() const{
+        return nAz_;
+    }
+
+    int nZd() const{
+        return nZd_;
+    }
+
+    /**
+     * @brief bin of a position
+     *
+     * @param az azimuth in degrees, wrapped to [0, 360)
+     * @param zd zenith distance in degrees, values outside of [0, 90] are clamped
+     * @return bin index
+     */
+    int bin(double az, double zd) const;
+
+    int count(int bin) const{
+        return counts_[bin];
+    }
+
+    /**
+     * @brief largest count of all bins
+     */
+    int maxCount() const;
+
+    /**
+     * @brief number of pointings inside the window
+     */
+    int total() const{
+        return total_;
+    }
+
+private:
+    double binSize_;                ///< bin width and height in degrees
+    int nAz_;                       ///< number of bins in azimuth
+    int nZd_;                       ///< number of bins in zenith distance
+
+    QVector<int> bin_;              ///< bin of each pointing
+    IntervalWindow window_;         ///< pointings inside the current window
+
+    QVector<int> counts_;           ///< number of pointings per bin
+    int total_;                     ///< number of pointings inside the window
+};
+
+#endif // SKYCOVERAGERASTER_H
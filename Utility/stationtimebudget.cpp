@@ -0,0 +1,85 @@
+/*
+ *  VieSched++ Very Long Baseline Interferometry (VLBI) Scheduling Software
+ *  Copyright (C) 2018  Matthias Schartner
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "stationtimebudget.h"
+
+#include <algorithm>
+
+StationTimeBudget::StationTimeBudget()
+{
+}
+
+void StationTimeBudget::build(const VieVS::Scheduler &schedule)
+{
+    int nsta = schedule.getNetwork().getNSta();
+    tracks_.clear();
+    tracks_.resize(nsta*nActivities);
+
+    for(const VieVS::Scan &scan : schedule.getScans()){
+        const VieVS::ScanTimes &t = scan.getTimes();
+        for(int i=0; i<scan.getNSta(); ++i){
+            Track *track = tracks_.data() + scan.getStationId(i)*nActivities;
+
+            track[static_cast<int>(Activity::fieldSystem)].starts.append(t.getFieldSystemTime(i,VieVS::Timestamp::start));
+            track[static_cast<int>(Activity::fieldSystem)].ends.append(t.getFieldSystemTime(i,VieVS::Timestamp::end));
+            track[static_cast<int>(Activity::slew)].starts.append(t.getSlewTime(i,VieVS::Timestamp::start));
+            track[static_cast<int>(Activity::slew)].ends.append(t.getSlewTime(i,VieVS::Timestamp::end));
+            track[static_cast<int>(Activity::idle)].starts.append(t.getIdleTime(i,VieVS::Timestamp::start));
+            track[static_cast<int>(Activity::idle)].ends.append(t.getIdleTime(i,VieVS::Timestamp::end));
+            track[static_cast<int>(Activity::preob)].starts.append(t.getPreobTime(i,VieVS::Timestamp::start));
+            track[static_cast<int>(Activity::preob)].ends.append(t.getPreobTime(i,VieVS::Timestamp::end));
+            track[static_cast<int>(Activity::observation)].starts.append(t.getObservingTime(i,VieVS::Timestamp::start));
+            track[static_cast<int>(Activity::observation)].ends.append(t.getObservingTime(i,VieVS::Timestamp::end));
+        }
+    }
+
+    for(Track &track : tracks_){
+        std::sort(track.starts.begin(), track.starts.end());
+        std::sort(track.ends.begin(), track.ends.end());
+
+        int n = track.starts.size();
+        track.startSum.resize(n+1);
+        track.endSum.resize(n+1);
+        track.startSum[0] = 0;
+        track.endSum[0] = 0;
+        for(int k=0; k<n; ++k){
+            track.startSum[k+1] = track.startSum[k] + track.starts[k];
+            track.endSum[k+1] = track.endSum[k] + track.ends[k];
+        }
+    }
+}
+
+qint64 StationTimeBudget::time(int staid, Activity activity, int start, int end) const
+{
+    if(end <= start){
+        return 0;
+    }
+    const Track &track = tracks_[staid*nActivities + static_cast<int>(activity)];
+    return accumulated(track, end) - accumulated(track, start);
+}
+
+qint64 StationTimeBudget::integral(const QVector<int> &times, const QVector<qint64> &sum, int x)
+{
+    int k = std::upper_bound(times.constBegin(), times.constEnd(), x) - times.constBegin();
+    return static_cast<qint64>(k)*x - sum[k];
+}
+
+qint64 StationTimeBudget::accumulated(const Track &track, int x) const
+{
+    return integral(track.starts, track.startSum, x) - integral(track.ends, track.endSum, x);
+}
@@ -0,0 +1,91 @@
+/*
+ *  VieSched++ Very Long Baseline Interferometry (VLBI) Scheduling Software
+ *  Copyright (C) 2018  Matthias Schartner
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef STATIONTIMEBUDGET_H
+#define STATIONTIMEBUDGET_H
+
+#include <QVector>
+
+#include "../VieSchedpp/Scheduler.h"
+
+/**
+ * @brief time spent per station and activity inside a time window
+ *
+ * For each station and activity, the start and end times of all intervals are sorted once and cumulative sums are
+ * stored. The time spent up to x is
+ *
+ *      F(x) = sum over starts s <= x of (x - s) - sum over ends e <= x of (x - e)
+ *
+ * which needs one binary search in each array. The time spent inside [start, end] is F(end) - F(start).
+ */
+class StationTimeBudget
+{
+public:
+
+    /**
+     * @brief station activity
+     */
+    enum class Activity{
+        fieldSystem,                ///< field system time
+        slew,                       ///< slew time
+        idle,                       ///< idle time
+        preob,                      ///< calibration time
+        observation,                ///< observing time
+    };
+
+    static const int nActivities = 5;
+
+    StationTimeBudget();
+
+    /**
+     * @brief collect and sort activity intervals of all stations
+     *
+     * @param schedule schedule
+     */
+    void build(const VieVS::Scheduler &schedule);
+
+    /**
+     * @brief time spent inside a time window
+     *
+     * @param staid station id
+     * @param activity activity
+     * @param start window start time in seconds since session start
+     * @param end window end time in seconds since session start
+     * @return time in seconds
+     */
+    qint64 time(int staid, Activity activity, int start, int end) const;
+
+private:
+    /**
+     * @brief sorted interval boundaries of one station and activity
+     */
+    struct Track{
+        QVector<int> starts;        ///< sorted interval start times
+        QVector<int> ends;          ///< sorted interval end times
+        QVector<qint64> startSum;   ///< startSum[k] = sum of the first k start times
+        QVector<qint64> endSum;     ///< endSum[k] = sum of the first k end times
+    };
+
+    QVector<Track> tracks_;         ///< tracks (nActivities per station)
+
+    static qint64 integral(const QVector<int> &times, const QVector<qint64> &sum, int x);
+
+    qint64 accumulated(const Track &track, int x) const;
+};
+
+#endif // STATIONTIMEBUDGET_H
@@ -9,6 +9,7 @@ Statistics::Statistics(
         QSpinBox *show_,
         QListWidget *statisticsCSV_,
         QCheckBox *removeMinimum_,
+        QCheckBox *follow_,
         QRadioButton *relative_,
         QRadioButton *absolute_,
         QLineEdit *outputPath_)
@@ -21,9 +22,35 @@ Statistics::Statistics(
     show = show_;
     statisticsCSV = statisticsCSV_;
     removeMinimum = removeMinimum_;
+    follow = follow_;
     relative = relative_;
     absolute = absolute_;
     outputPath = outputPath_;
+
+    windowStart = 0;
+    statisticsYMin = 0;
+    statisticsYMax = 1;
+
+    loadWatcher = new QFutureWatcher<StatisticsMatrix::Block>(this);
+    loadProgress = new QProgressDialog("reading statistics files...", "Cancel", 0, 0, itemlist);
+    loadProgress->setWindowTitle("statistics");
+    loadProgress->setWindowModality(Qt::WindowModal);
+    loadProgress->setMinimumDuration(500);
+    loadProgress->reset();
+
+    connect(loadWatcher,SIGNAL(progressRangeChanged(int,int)),loadProgress,SLOT(setRange(int,int)));
+    connect(loadWatcher,SIGNAL(progressValueChanged(int)),loadProgress,SLOT(setValue(int)));
+    connect(loadProgress,SIGNAL(canceled()),loadWatcher,SLOT(cancel()));
+    connect(loadWatcher,SIGNAL(finished()),this,SLOT(statisticsLoaded()));
+
+    // VieSchedpp writes one line per version, collect a few of them before updating the plot
+    fileWatcher = new QFileSystemWatcher(this);
+    followTimer = new QTimer(this);
+    followTimer->setSingleShot(true);
+    followTimer->setInterval(500);
+    connect(fileWatcher,SIGNAL(fileChanged(QString)),this,SLOT(statisticsFileChanged(QString)));
+    connect(followTimer,SIGNAL(timeout()),this,SLOT(followStatistics()));
+    connect(follow,SIGNAL(toggled(bool)),this,SLOT(on_checkBox_statistics_follow_toggled(bool)));
 }
 
 void Statistics::setupStatisticView()
@@ -41,12 +68,16 @@ void Statistics::setupStatisticView()
     scrollBar->setRange(0,0);
     scrollBar->setSingleStep(1);
 
-    for(int i=0; i<itemlist->topLevelItemCount(); ++i){
-        auto db = new QDoubleSpinBox(itemlist);
-        db->setMinimum(-99);
-        itemlist->setItemWidget(itemlist->topLevelItem(i),2,db);
-        connect(db,SIGNAL(valueChanged(double)),this,SLOT(plotStatistics()));
-    }
+    // weights are stored in the item model, spin boxes are only created while a weight is edited
+    itemlist->setItemDelegateForColumn(2, new DoubleSpinBoxDelegate("", itemlist, -99, 99, 2));
+    itemlist->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    connect(itemlist,SIGNAL(itemClicked(QTreeWidgetItem*,int)),this,SLOT(editWeight(QTreeWidgetItem*,int)));
+
+    // collect several weight changes before the versions are scored again
+    scoreTimer = new QTimer(this);
+    scoreTimer->setSingleShot(true);
+    scoreTimer->setInterval(250);
+    connect(scoreTimer,SIGNAL(timeout()),this,SLOT(plotStatistics()));
 
 
     connect(absolute,SIGNAL(toggled(bool)),this,SLOT(plotStatistics()));
@@ -54,6 +85,37 @@ void Statistics::setupStatisticView()
 
     hoveredTitle->setStyleSheet("font-weight: bold");
 
+    // ranking of versions
+    rankingBox = new QGroupBox("ranking");
+    QVBoxLayout *rankingLayout = new QVBoxLayout(rankingBox);
+    QHBoxLayout *rankingControls = new QHBoxLayout();
+    rankingControls->addWidget(new QLabel("show top"));
+    rankingTopK = new QSpinBox();
+    rankingTopK->setRange(1,10000);
+    rankingTopK->setValue(10);
+    rankingTopK->setToolTip("number of versions with the highest score");
+    rankingTopK->setStatusTip("number of versions with the highest score");
+    rankingControls->addWidget(rankingTopK);
+    QPushButton *paretoFront = new QPushButton("Pareto front");
+    paretoFront->setToolTip("non-dominated versions over all checked statistics (larger is better, smaller is better for negative weights)");
+    paretoFront->setStatusTip("non-dominated versions over all checked statistics (larger is better, smaller is better for negative weights)");
+    rankingControls->addWidget(paretoFront);
+    rankingControls->addStretch(1);
+    rankingLayout->addLayout(rankingControls);
+    rankingTree = new QTreeWidget();
+    rankingTree->setHeaderLabels(QStringList() << "rank" << "version" << "session" << "score");
+    rankingTree->setRootIsDecorated(false);
+    rankingTree->setMaximumHeight(150);
+    rankingTree->setToolTip("double click to scroll to version");
+    rankingTree->header()->setSectionResizeMode(QHeaderView::ResizeToContents);
+    rankingLayout->addWidget(rankingTree);
+    layout->addWidget(rankingBox);
+    rankingPareto = false;
+
+    connect(rankingTopK,SIGNAL(valueChanged(int)),this,SLOT(on_spinBox_rankingTopK_valueChanged()));
+    connect(paretoFront,SIGNAL(clicked()),this,SLOT(on_pushButton_paretoFront_clicked()));
+    connect(rankingTree,SIGNAL(itemDoubleClicked(QTreeWidgetItem*,int)),this,SLOT(rankingItemDoubleClicked(QTreeWidgetItem*)));
+
     general << "#scans" << "#single source scans" << "#subnetting scans" << "#fillin-mode scans" << "#calibrator_scans" << "#observations" << "#stations" << "#sources";
     weightFactors << "weight_factor_sky-coverage"
                   << "weight_factor_number_of_observations"
@@ -89,9 +151,7 @@ void Statistics::on_pushButton_addStatistic_clicked()
 void Statistics::on_pushButton_removeStatistic_clicked()
 {
     if(statisticsCSV->selectedItems().size()==1){
-        QString txt = statisticsCSV->selectedItems().at(0)->text();
         int row = statisticsCSV->selectionModel()->selectedRows(0).at(0).row();
-        statistics.remove(txt);
         delete statisticsCSV->item(row);
 
         reload();
@@ -100,131 +160,104 @@ void Statistics::on_pushButton_removeStatistic_clicked()
 
 void Statistics::reload()
 {
-    // ################# read header line #################
+    // ################# read statistics files in parallel #################
+    if(loadWatcher->isRunning()){
+        loadWatcher->cancel();
+        loadWatcher->waitForFinished();
+    }
+
+    QStringList paths;
+    for(int i=0; i<statisticsCSV->count(); ++i){
+        paths << statisticsCSV->item(i)->text();
+    }
+
+    StatisticsMatrix::pruneCache();
+
+    loadProgress->setRange(0, paths.size());
+    loadProgress->setValue(0);
+    loadWatcher->setFuture(QtConcurrent::mapped(paths, StatisticsMatrix::parseFile));
+}
+
+void Statistics::statisticsLoaded()
+{
+    loadProgress->reset();
+    if(loadWatcher->isCanceled()){
+        return;
+    }
+
+    // ################# merge statistics files #################
     stations.clear();
     baselines.clear();
     sources.clear();
     times.clear();
     multiScheduling.clear();
-    lookupTable.clear();
-
-    for(int i=0; i<statisticsCSV->count(); ++i){
-        QString path = statisticsCSV->item(i)->text();
-        QStringList tmp = path.split("/");
-        QString folder = tmp.at(tmp.size()-2);
-        QFile file(path);
-        if (!file.open(QIODevice::ReadOnly)) {
-            QMessageBox::warning(this,"could not open file!","Error while opening:\n"+path,QMessageBox::Ok);
-            return;
-        }
-
-        QTextStream in(&file);
-        QString line = in.readLine();
-        QStringList names = line.split(",",QString::SplitBehavior::SkipEmptyParts);
-        bool lookForMultiSchedulingParameteres = false;
-        for(const auto &name : names){
-            lookupTable.append(name);
 
-            if( name.left(10) == "n_sta_obs_" ){
-                QString thisName = name.mid(10);
-                if(stations.indexOf(thisName) == -1){
-                    stations.append(thisName);
-                }
-            }else if( name.left(9) == "n_bl_obs_" ){
-                QString thisName = name.mid(9);
-                if(baselines.indexOf(thisName) == -1){
-                    baselines.append(thisName);
-                }
-            }else if( name.left(10) == "n_src_obs_" ){
-                QString thisName = name.mid(10);
-                if(sources.indexOf(thisName) == -1){
-                    sources.append(thisName);
-                }
-                lookForMultiSchedulingParameteres = true;
-            }else if( name.left(4) == "sim_") {
-                continue;
-            }else if(lookForMultiSchedulingParameteres){
-                if(multiScheduling.indexOf(name) == -1){
-                    multiScheduling.append(name);
-                }
-            }
+    QFuture<StatisticsMatrix::Block> future = loadWatcher->future();
+    QVector<StatisticsMatrix::Block> blocks;
+    for(int i=0; i<future.resultCount(); ++i){
+        blocks.append(future.resultAt(i));
+    }
+    QString errorPath;
+    QString errorMessage;
+    if(!statistics.merge(blocks, errorPath, errorMessage)){
+        QMessageBox::warning(this,"could not open file!","Error while opening:\n"+errorPath+"\n"+errorMessage,QMessageBox::Ok);
+        return;
+    }
+    on_checkBox_statistics_follow_toggled(follow->isChecked());
+
+    // ################# categorize header #################
+    // header names are unique, therefore every station, baseline, source and parameter shows up exactly once
+    bool lookForMultiSchedulingParameteres = false;
+    for(const auto &name : statistics.header()){
+        if( name.left(10) == "n_sta_obs_" ){
+            stations.append(name.mid(10));
+        }else if( name.left(9) == "n_bl_obs_" ){
+            baselines.append(name.mid(9));
+        }else if( name.left(10) == "n_src_obs_" ){
+            sources.append(name.mid(10));
+            lookForMultiSchedulingParameteres = true;
+        }else if( name.left(4) == "sim_") {
+            continue;
+        }else if(lookForMultiSchedulingParameteres){
+            multiScheduling.append(name);
         }
     }
     //stations.sort();
     //baselines.sort();
 
-    // ################# read data #################
-    statistics.clear();
-    QVector<int> counter(lookupTable.size(),0);
-    for(int i=0; i<statisticsCSV->count(); ++i){
-        QString path = statisticsCSV->item(i)->text();
-        QStringList tmp = path.split("/");
-        QString folder = tmp.at(tmp.size()-2);
-
-        QFile file(path);
-        if (!file.open(QIODevice::ReadOnly)) {
-            QMessageBox::warning(this,"could not open file!","Error while opening:\n"+path,QMessageBox::Ok);
-            return;
-        }
-
-        QTextStream in(&file);
-        QString line = in.readLine();
-        QStringList header = line.split(",",QString::SplitBehavior::SkipEmptyParts);
-
-        while (!in.atEnd()){
-            QString line = in.readLine();
-            QStringList split = line.split(",",QString::SplitBehavior::SkipEmptyParts);
-
-            int version = split.at(0).toInt();
-            statistics[folder][version] = QVector<double>(lookupTable.size(), 0.0);
-
-            for(int i = 1; i<split.count();++i){
-                const QString &name = header.at(i);
-                double value = split.at(i).toDouble();
-                int idx = lookupTable.indexOf(name);
-
-                if(idx == -1){
-                    continue;
-                }
-                if(value != 0){
-                    ++counter[idx];
-                }
-                statistics[folder][version][idx] = value;
-            }
-        }
-    }
+    // ################# remove unobserved sources #################
     int offset = 1 + general.size() + 5+5*stations.size() +6+6*stations.size() + 2*stations.size() + baselines.size() + 14;
     QList<char> remove;
     for (int i=offset; i<offset+sources.size(); ++i) {
-        if(counter[i] > 0){
-            remove.append(false);
-        }else{
-            remove.append(true);
+        bool observed = false;
+        if(i < statistics.columnCount()){
+            const double *col = statistics.column(i);
+            for(int row=0; row<statistics.rowCount(); ++row){
+                if(col[row] != 0){
+                    observed = true;
+                    break;
+                }
+            }
         }
+        remove.append(!observed);
     }
-    QList<int> removeIdx;
     int nSrc = sources.size();
-    for(int i=remove.size()-1; i>=0; --i){
-        if(remove[i]){
-            sources.removeAt(i);
-            lookupTable.removeAt(i+nSrc+offset);
-            removeIdx.append(i+nSrc+offset);
-        }
-    }
-    for(int i=remove.size()-1; i>=0; --i){
+    QVector<char> keep(statistics.columnCount(), true);
+    QStringList observedSources;
+    for(int i=0; i<remove.size(); ++i){
         if(remove[i]){
-            lookupTable.removeAt(i+offset);
-            removeIdx.append(i+offset);
-        }
-    }
-
-    for(auto & any: statistics){
-        for(auto & any2: any){
-            for(int i : removeIdx){
-                any2.removeAt(i);
+            if(i+offset < keep.size()){
+                keep[i+offset] = false;
+            }
+            if(i+nSrc+offset < keep.size()){
+                keep[i+nSrc+offset] = false;
             }
+        }else{
+            observedSources.append(sources.at(i));
         }
     }
+    sources = observedSources;
+    statistics.removeColumns(keep);
     //sources.sort();
 
     // ################# add items to itemlist #################
@@ -243,10 +276,7 @@ void Statistics::reload()
         }
 
 
-        auto db = new QDoubleSpinBox(itemlist);
-        db->setMinimum(-99);
-        itemlist->setItemWidget(gen->child(gen->childCount()-1),2,db);
-        connect(db,SIGNAL(valueChanged(double)),this,SLOT(plotStatistics()));
+        addWeight(gen->child(gen->childCount()-1));
     }
     gen->setExpanded(true);
 
@@ -264,18 +294,12 @@ void Statistics::reload()
         staScans->addChild(new QTreeWidgetItem(QStringList() << any));
         staScans->child(staScans->childCount()-1)->setCheckState(0,Qt::Unchecked);
 
-        auto db1 = new QDoubleSpinBox(itemlist);
-        db1->setMinimum(-99);
-        itemlist->setItemWidget(staScans->child(staScans->childCount()-1),2,db1);
-        connect(db1,SIGNAL(valueChanged(double)),this,SLOT(plotStatistics()));
+        addWeight(staScans->child(staScans->childCount()-1));
 
         staObs->addChild(new QTreeWidgetItem(QStringList() << any));
         staObs->child(staObs->childCount()-1)->setCheckState(0,Qt::Unchecked);
 
-        auto db2 = new QDoubleSpinBox(itemlist);
-        db2->setMinimum(-99);
-        itemlist->setItemWidget(staObs->child(staObs->childCount()-1),2,db2);
-        connect(db2,SIGNAL(valueChanged(double)),this,SLOT(plotStatistics()));
+        addWeight(staObs->child(staObs->childCount()-1));
     }
 
     itemlist->addTopLevelItem(new QTreeWidgetItem(QStringList() << "baseline"));
@@ -288,10 +312,7 @@ void Statistics::reload()
         blObs->addChild(new QTreeWidgetItem(QStringList() << any));
         blObs->child(blObs->childCount()-1)->setCheckState(0,Qt::Unchecked);
 
-        auto db2 = new QDoubleSpinBox(itemlist);
-        db2->setMinimum(-99);
-        itemlist->setItemWidget(blObs->child(blObs->childCount()-1),2,db2);
-        connect(db2,SIGNAL(valueChanged(double)),this,SLOT(plotStatistics()));
+        addWeight(blObs->child(blObs->childCount()-1));
     }
 
 
@@ -309,18 +330,12 @@ void Statistics::reload()
         srcScans->addChild(new QTreeWidgetItem(QStringList() << any));
         srcScans->child(srcScans->childCount()-1)->setCheckState(0,Qt::Unchecked);
 
-        auto db1 = new QDoubleSpinBox(itemlist);
-        db1->setMinimum(-99);
-        itemlist->setItemWidget(srcScans->child(srcScans->childCount()-1),2,db1);
-        connect(db1,SIGNAL(valueChanged(double)),this,SLOT(plotStatistics()));
+        addWeight(srcScans->child(srcScans->childCount()-1));
 
         srcObs->addChild(new QTreeWidgetItem(QStringList() << any));
         srcObs->child(srcObs->childCount()-1)->setCheckState(0,Qt::Unchecked);
 
-        auto db2 = new QDoubleSpinBox(itemlist);
-        db2->setMinimum(-99);
-        itemlist->setItemWidget(srcObs->child(srcObs->childCount()-1),2,db2);
-        connect(db2,SIGNAL(valueChanged(double)),this,SLOT(plotStatistics()));
+        addWeight(srcObs->child(srcObs->childCount()-1));
     }
 
     itemlist->addTopLevelItem(new QTreeWidgetItem(QStringList() << "weight factors"));
@@ -331,10 +346,7 @@ void Statistics::reload()
         wf->addChild(new QTreeWidgetItem(QStringList() << any.mid(14).replace("_"," ")));
         wf->child(wf->childCount()-1)->setCheckState(0,Qt::Unchecked);
 
-        auto db = new QDoubleSpinBox(itemlist);
-        db->setMinimum(-99);
-        itemlist->setItemWidget(wf->child(wf->childCount()-1),2,db);
-        connect(db,SIGNAL(valueChanged(double)),this,SLOT(plotStatistics()));
+        addWeight(wf->child(wf->childCount()-1));
     }
 
 
@@ -346,10 +358,7 @@ void Statistics::reload()
         ms->addChild(new QTreeWidgetItem(QStringList() << any.replace("_"," ")));
         ms->child(ms->childCount()-1)->setCheckState(0,Qt::Unchecked);
 
-        auto db = new QDoubleSpinBox(itemlist);
-        db->setMinimum(-99);
-        itemlist->setItemWidget(ms->child(ms->childCount()-1),2,db);
-        connect(db,SIGNAL(valueChanged(double)),this,SLOT(plotStatistics()));
+        addWeight(ms->child(ms->childCount()-1));
     }
 
     // time spend
@@ -372,10 +381,7 @@ void Statistics::reload()
             tavg->addChild(new QTreeWidgetItem(QStringList() << any));
             tavg->child(tavg->childCount()-1)->setCheckState(0,Qt::Unchecked);
 
-            auto db = new QDoubleSpinBox(itemlist);
-            db->setMinimum(-99);
-            itemlist->setItemWidget(tavg->child(tavg->childCount()-1),2,db);
-            connect(db,SIGNAL(valueChanged(double)),this,SLOT(plotStatistics()));
+            addWeight(tavg->child(tavg->childCount()-1));
         }
 
 
@@ -385,10 +391,7 @@ void Statistics::reload()
             tobs->addChild(new QTreeWidgetItem(QStringList() << any));
             tobs->child(tobs->childCount()-1)->setCheckState(0,Qt::Unchecked);
 
-            auto db = new QDoubleSpinBox(itemlist);
-            db->setMinimum(-99);
-            itemlist->setItemWidget(tobs->child(tobs->childCount()-1),2,db);
-            connect(db,SIGNAL(valueChanged(double)),this,SLOT(plotStatistics()));
+            addWeight(tobs->child(tobs->childCount()-1));
         }
 
         const auto &tpre = t->child(2);
@@ -397,10 +400,7 @@ void Statistics::reload()
             tpre->addChild(new QTreeWidgetItem(QStringList() << any));
             tpre->child(tpre->childCount()-1)->setCheckState(0,Qt::Unchecked);
 
-            auto db = new QDoubleSpinBox(itemlist);
-            db->setMinimum(-99);
-            itemlist->setItemWidget(tpre->child(tpre->childCount()-1),2,db);
-            connect(db,SIGNAL(valueChanged(double)),this,SLOT(plotStatistics()));
+            addWeight(tpre->child(tpre->childCount()-1));
         }
 
         const auto &tslew = t->child(3);
@@ -409,10 +409,7 @@ void Statistics::reload()
             tslew->addChild(new QTreeWidgetItem(QStringList() << any));
             tslew->child(tslew->childCount()-1)->setCheckState(0,Qt::Unchecked);
 
-            auto db = new QDoubleSpinBox(itemlist);
-            db->setMinimum(-99);
-            itemlist->setItemWidget(tslew->child(tslew->childCount()-1),2,db);
-            connect(db,SIGNAL(valueChanged(double)),this,SLOT(plotStatistics()));
+            addWeight(tslew->child(tslew->childCount()-1));
         }
 
         const auto &tidle = t->child(4);
@@ -421,10 +418,7 @@ void Statistics::reload()
             tidle->addChild(new QTreeWidgetItem(QStringList() << any));
             tidle->child(tidle->childCount()-1)->setCheckState(0,Qt::Unchecked);
 
-            auto db = new QDoubleSpinBox(itemlist);
-            db->setMinimum(-99);
-            itemlist->setItemWidget(tidle->child(tidle->childCount()-1),2,db);
-            connect(db,SIGNAL(valueChanged(double)),this,SLOT(plotStatistics()));
+            addWeight(tidle->child(tidle->childCount()-1));
         }
 
         const auto &tfield = t->child(5);
@@ -433,10 +427,7 @@ void Statistics::reload()
             tfield->addChild(new QTreeWidgetItem(QStringList() << any));
             tfield->child(tfield->childCount()-1)->setCheckState(0,Qt::Unchecked);
 
-            auto db = new QDoubleSpinBox(itemlist);
-            db->setMinimum(-99);
-            itemlist->setItemWidget(tfield->child(tfield->childCount()-1),2,db);
-            connect(db,SIGNAL(valueChanged(double)),this,SLOT(plotStatistics()));
+            addWeight(tfield->child(tfield->childCount()-1));
         }
     }
 
@@ -461,10 +452,7 @@ void Statistics::reload()
             stavg->addChild(new QTreeWidgetItem(QStringList() << any));
             stavg->child(stavg->childCount()-1)->setCheckState(0,Qt::Unchecked);
 
-            auto db = new QDoubleSpinBox(itemlist);
-            db->setMinimum(-99);
-            itemlist->setItemWidget(stavg->child(stavg->childCount()-1),2,db);
-            connect(db,SIGNAL(valueChanged(double)),this,SLOT(plotStatistics()));
+            addWeight(stavg->child(stavg->childCount()-1));
         }
 
 
@@ -474,10 +462,7 @@ void Statistics::reload()
             ta13m30->addChild(new QTreeWidgetItem(QStringList() << any));
             ta13m30->child(ta13m30->childCount()-1)->setCheckState(0,Qt::Unchecked);
 
-            auto db = new QDoubleSpinBox(itemlist);
-            db->setMinimum(-99);
-            itemlist->setItemWidget(ta13m30->child(ta13m30->childCount()-1),2,db);
-            connect(db,SIGNAL(valueChanged(double)),this,SLOT(plotStatistics()));
+            addWeight(ta13m30->child(ta13m30->childCount()-1));
         }
         const auto &ta25m30 = st->child(2);
         for(const auto &any : stations){
@@ -485,10 +470,7 @@ void Statistics::reload()
             ta25m30->addChild(new QTreeWidgetItem(QStringList() << any));
             ta25m30->child(ta25m30->childCount()-1)->setCheckState(0,Qt::Unchecked);
 
-            auto db = new QDoubleSpinBox(itemlist);
-            db->setMinimum(-99);
-            itemlist->setItemWidget(ta25m30->child(ta25m30->childCount()-1),2,db);
-            connect(db,SIGNAL(valueChanged(double)),this,SLOT(plotStatistics()));
+            addWeight(ta25m30->child(ta25m30->childCount()-1));
         }
         const auto &ta37m30 = st->child(3);
         for(const auto &any : stations){
@@ -496,10 +478,7 @@ void Statistics::reload()
             ta37m30->addChild(new QTreeWidgetItem(QStringList() << any));
             ta37m30->child(ta37m30->childCount()-1)->setCheckState(0,Qt::Unchecked);
 
-            auto db = new QDoubleSpinBox(itemlist);
-            db->setMinimum(-99);
-            itemlist->setItemWidget(ta37m30->child(ta37m30->childCount()-1),2,db);
-            connect(db,SIGNAL(valueChanged(double)),this,SLOT(plotStatistics()));
+            addWeight(ta37m30->child(ta37m30->childCount()-1));
         }
         const auto &ta13m60 = st->child(4);
         for(const auto &any : stations){
@@ -507,10 +486,7 @@ void Statistics::reload()
             ta13m60->addChild(new QTreeWidgetItem(QStringList() << any));
             ta13m60->child(ta13m60->childCount()-1)->setCheckState(0,Qt::Unchecked);
 
-            auto db = new QDoubleSpinBox(itemlist);
-            db->setMinimum(-99);
-            itemlist->setItemWidget(ta13m60->child(ta13m60->childCount()-1),2,db);
-            connect(db,SIGNAL(valueChanged(double)),this,SLOT(plotStatistics()));
+            addWeight(ta13m60->child(ta13m60->childCount()-1));
         }
         const auto &ta25m60 = st->child(5);
         for(const auto &any : stations){
@@ -518,10 +494,7 @@ void Statistics::reload()
             ta25m60->addChild(new QTreeWidgetItem(QStringList() << any));
             ta25m60->child(ta25m60->childCount()-1)->setCheckState(0,Qt::Unchecked);
 
-            auto db = new QDoubleSpinBox(itemlist);
-            db->setMinimum(-99);
-            itemlist->setItemWidget(ta25m60->child(ta25m60->childCount()-1),2,db);
-            connect(db,SIGNAL(valueChanged(double)),this,SLOT(plotStatistics()));
+            addWeight(ta25m60->child(ta25m60->childCount()-1));
         }
         const auto &ta37m60 = st->child(6);
         for(const auto &any : stations){
@@ -529,10 +502,7 @@ void Statistics::reload()
             ta37m60->addChild(new QTreeWidgetItem(QStringList() << any));
             ta37m60->child(ta37m60->childCount()-1)->setCheckState(0,Qt::Unchecked);
 
-            auto db = new QDoubleSpinBox(itemlist);
-            db->setMinimum(-99);
-            itemlist->setItemWidget(ta37m60->child(ta37m60->childCount()-1),2,db);
-            connect(db,SIGNAL(valueChanged(double)),this,SLOT(plotStatistics()));
+            addWeight(ta37m60->child(ta37m60->childCount()-1));
         }
     }
 
@@ -560,17 +530,11 @@ void Statistics::reload()
                 itm->addChild(new QTreeWidgetItem(QStringList() << any));
                 itm->child(itm->childCount()-1)->setCheckState(0,Qt::Unchecked);
 
-                auto db = new QDoubleSpinBox(itemlist);
-                db->setMinimum(-99);
-                itemlist->setItemWidget(itm->child(itm->childCount()-1),2,db);
-                connect(db,SIGNAL(valueChanged(double)),this,SLOT(plotStatistics()));
+                addWeight(itm->child(itm->childCount()-1));
             }
             itm->addChild(new QTreeWidgetItem(QStringList() << "average 3d coordinates [mm]"));
             itm->child(itm->childCount()-1)->setCheckState(0,Qt::Unchecked);
-            auto db = new QDoubleSpinBox(itemlist);
-            db->setMinimum(-99);
-            itemlist->setItemWidget(itm->child(itm->childCount()-1),2,db);
-            connect(db,SIGNAL(valueChanged(double)),this,SLOT(plotStatistics()));
+            addWeight(itm->child(itm->childCount()-1));
 
 
             itm->addChild(new QTreeWidgetItem(QStringList() << "3d coordinates [mm]"));
@@ -581,10 +545,7 @@ void Statistics::reload()
                 iitm->addChild(new QTreeWidgetItem(QStringList() << sta));
                 iitm->child(iitm->childCount()-1)->setCheckState(0,Qt::Unchecked);
 
-                auto db = new QDoubleSpinBox(itemlist);
-                db->setMinimum(-99);
-                itemlist->setItemWidget(iitm->child(iitm->childCount()-1),2,db);
-                connect(db,SIGNAL(valueChanged(double)),this,SLOT(plotStatistics()));
+                addWeight(iitm->child(iitm->childCount()-1));
 
             }
         }
@@ -597,12 +558,57 @@ void Statistics::reload()
 
 }
 
-void Statistics::addEmptyStatistic(int idx)
+void Statistics::on_checkBox_statistics_follow_toggled(bool checked)
 {
-    for(const auto &key1: statistics.keys()){
-        for(const auto &key2: statistics[key1].keys()){
-            statistics[key1][key2].insert(idx,0);
+    if(!fileWatcher->files().isEmpty()){
+        fileWatcher->removePaths(fileWatcher->files());
+    }
+    followTimer->stop();
+
+    if(checked){
+        for(int i=0; i<statistics.fileCount(); ++i){
+            fileWatcher->addPath(statistics.path(i));
         }
+        followTimer->start();
+    }
+}
+
+void Statistics::statisticsFileChanged(const QString &path)
+{
+    // some writers replace the file, in this case the watcher drops it
+    if(QFile::exists(path) && !fileWatcher->files().contains(path)){
+        fileWatcher->addPath(path);
+    }
+    if(!followTimer->isActive()){
+        followTimer->start();
+    }
+}
+
+void Statistics::followStatistics()
+{
+    if(loadWatcher->isRunning()){
+        return;
+    }
+
+    int nColumns = statistics.columnCount();
+    int nNew = 0;
+    for(int i=0; i<statistics.fileCount(); ++i){
+        int n = statistics.readAppended(i);
+        if(n == -1){
+            reload();
+            return;
+        }
+        nNew += n;
+    }
+
+    // a header which was incomplete while loading added new columns, the item list has to be rebuilt
+    if(statistics.columnCount() != nColumns){
+        reload();
+        return;
+    }
+
+    if(nNew > 0){
+        plotStatistics(false);
     }
 }
 
@@ -653,10 +659,14 @@ void Statistics::plotStatistics(bool animation)
         brushes.push_back(QBrush(colors.at(i),Qt::CrossPattern));
     }
 
-    // ################# create bar sets #################
+    // ################# collect checked statistics #################
 
-    QVector<QBarSet*> barSets;
+    // only label, brush and column of each checked statistic are kept, the bars itself are created for the visible
+    // window in plotStatisticsWindow
     int counter = 0;
+    checkedLabels.clear();
+    checkedBrushes.clear();
+    checkedColumns.clear();
 
 
     const auto &gen = itemlist->topLevelItem(0);
@@ -698,10 +708,11 @@ void Statistics::plotStatistics(bool animation)
         const auto &child = gen->child(i);
         if(child->checkState(0) == Qt::Checked){
             QString name = QString("n_").append(child->text(0).mid(1).replace(" ","_"));
-            barSets.push_back(statisticsBarSet(offset,name));
+            checkedLabels.append(name);
+            checkedColumns.append(offset);
             child->setBackground(1,brushes.at(counter));
 
-            barSets.at(barSets.count()-1)->setBrush(brushes.at(counter));
+            checkedBrushes.append(brushes.at(counter));
             ++counter;
             counter = counter%brushes.count();
         }else{
@@ -715,10 +726,11 @@ void Statistics::plotStatistics(bool animation)
         const auto &child = time_avg->child(i);
         if(child->checkState(0) == Qt::Checked){
             QString name = QString("time_average_").append(child->text(0).replace(" ","_"));
-            barSets.push_back(statisticsBarSet(offset,name));
+            checkedLabels.append(name);
+            checkedColumns.append(offset);
             child->setBackground(1,brushes.at(counter));
 
-            barSets.at(barSets.count()-1)->setBrush(brushes.at(counter));
+            checkedBrushes.append(brushes.at(counter));
             ++counter;
             counter = counter%brushes.count();
         }else{
@@ -731,10 +743,11 @@ void Statistics::plotStatistics(bool animation)
         const auto &child = skyCov_avg->child(i);
         if(child->checkState(0) == Qt::Checked){
             QString name = QString("sky-coverage_average_").append(child->text(0).replace(" ","_"));
-            barSets.push_back(statisticsBarSet(offset,name));
+            checkedLabels.append(name);
+            checkedColumns.append(offset);
             child->setBackground(1,brushes.at(counter));
 
-            barSets.at(barSets.count()-1)->setBrush(brushes.at(counter));
+            checkedBrushes.append(brushes.at(counter));
             ++counter;
             counter = counter%brushes.count();
         }else{
@@ -748,10 +761,11 @@ void Statistics::plotStatistics(bool animation)
         const auto &child = wf->child(i);
         if(child->checkState(0) == Qt::Checked){
             QString name = QString("weight_factor_").append(child->text(0).replace(" ","_"));
-            barSets.push_back(statisticsBarSet(offset,name));
+            checkedLabels.append(name);
+            checkedColumns.append(offset);
             child->setBackground(1,brushes.at(counter));
 
-            barSets.at(barSets.count()-1)->setBrush(brushes.at(counter));
+            checkedBrushes.append(brushes.at(counter));
             ++counter;
             counter = counter%brushes.count();
         }else{
@@ -766,10 +780,11 @@ void Statistics::plotStatistics(bool animation)
         const auto &child = time_obs->child(i);
         if(child->checkState(0) == Qt::Checked){
             QString name = QString("time_").append(child->text(0)).append("_observation");
-            barSets.push_back(statisticsBarSet(offset,name));
+            checkedLabels.append(name);
+            checkedColumns.append(offset);
             child->setBackground(1,brushes.at(counter));
 
-            barSets.at(barSets.count()-1)->setBrush(brushes.at(counter));
+            checkedBrushes.append(brushes.at(counter));
             ++counter;
             counter = counter%brushes.count();
         }else{
@@ -781,10 +796,11 @@ void Statistics::plotStatistics(bool animation)
         const auto &child = time_preob->child(i);
         if(child->checkState(0) == Qt::Checked){
             QString name = QString("time_").append(child->text(0)).append("_preob");
-            barSets.push_back(statisticsBarSet(offset,name));
+            checkedLabels.append(name);
+            checkedColumns.append(offset);
             child->setBackground(1,brushes.at(counter));
 
-            barSets.at(barSets.count()-1)->setBrush(brushes.at(counter));
+            checkedBrushes.append(brushes.at(counter));
             ++counter;
             counter = counter%brushes.count();
         }else{
@@ -796,10 +812,11 @@ void Statistics::plotStatistics(bool animation)
         const auto &child = time_slew->child(i);
         if(child->checkState(0) == Qt::Checked){
             QString name = QString("time_").append(child->text(0)).append("_slew");
-            barSets.push_back(statisticsBarSet(offset,name));
+            checkedLabels.append(name);
+            checkedColumns.append(offset);
             child->setBackground(1,brushes.at(counter));
 
-            barSets.at(barSets.count()-1)->setBrush(brushes.at(counter));
+            checkedBrushes.append(brushes.at(counter));
             ++counter;
             counter = counter%brushes.count();
         }else{
@@ -811,10 +828,11 @@ void Statistics::plotStatistics(bool animation)
         const auto &child = time_idle->child(i);
         if(child->checkState(0) == Qt::Checked){
             QString name = QString("time_").append(child->text(0)).append("_idle");
-            barSets.push_back(statisticsBarSet(offset,name));
+            checkedLabels.append(name);
+            checkedColumns.append(offset);
             child->setBackground(1,brushes.at(counter));
 
-            barSets.at(barSets.count()-1)->setBrush(brushes.at(counter));
+            checkedBrushes.append(brushes.at(counter));
             ++counter;
             counter = counter%brushes.count();
         }else{
@@ -826,10 +844,11 @@ void Statistics::plotStatistics(bool animation)
         const auto &child = time_field->child(i);
         if(child->checkState(0) == Qt::Checked){
             QString name = QString("time_").append(child->text(0)).append("_field_system");
-            barSets.push_back(statisticsBarSet(offset,name));
+            checkedLabels.append(name);
+            checkedColumns.append(offset);
             child->setBackground(1,brushes.at(counter));
 
-            barSets.at(barSets.count()-1)->setBrush(brushes.at(counter));
+            checkedBrushes.append(brushes.at(counter));
             ++counter;
             counter = counter%brushes.count();
         }else{
@@ -843,10 +862,11 @@ void Statistics::plotStatistics(bool animation)
         const auto &child = skyCov_a13m30->child(i);
         if(child->checkState(0) == Qt::Checked){
             QString name = QString("sky-coverage_").append(child->text(0)).append("_13_areas_30_min");
-            barSets.push_back(statisticsBarSet(offset,name));
+            checkedLabels.append(name);
+            checkedColumns.append(offset);
             child->setBackground(1,brushes.at(counter));
 
-            barSets.at(barSets.count()-1)->setBrush(brushes.at(counter));
+            checkedBrushes.append(brushes.at(counter));
             ++counter;
             counter = counter%brushes.count();
         }else{
@@ -858,10 +878,11 @@ void Statistics::plotStatistics(bool animation)
         const auto &child = skyCov_a25m30->child(i);
         if(child->checkState(0) == Qt::Checked){
             QString name = QString("sky-coverage_").append(child->text(0)).append("_25_areas_30_min");
-            barSets.push_back(statisticsBarSet(offset,name));
+            checkedLabels.append(name);
+            checkedColumns.append(offset);
             child->setBackground(1,brushes.at(counter));
 
-            barSets.at(barSets.count()-1)->setBrush(brushes.at(counter));
+            checkedBrushes.append(brushes.at(counter));
             ++counter;
             counter = counter%brushes.count();
         }else{
@@ -873,10 +894,11 @@ void Statistics::plotStatistics(bool animation)
         const auto &child = skyCov_a37m30->child(i);
         if(child->checkState(0) == Qt::Checked){
             QString name = QString("sky-coverage_").append(child->text(0)).append("_37_areas_30_min");
-            barSets.push_back(statisticsBarSet(offset,name));
+            checkedLabels.append(name);
+            checkedColumns.append(offset);
             child->setBackground(1,brushes.at(counter));
 
-            barSets.at(barSets.count()-1)->setBrush(brushes.at(counter));
+            checkedBrushes.append(brushes.at(counter));
             ++counter;
             counter = counter%brushes.count();
         }else{
@@ -888,10 +910,11 @@ void Statistics::plotStatistics(bool animation)
         const auto &child = skyCov_a13m60->child(i);
         if(child->checkState(0) == Qt::Checked){
             QString name = QString("sky-coverage_").append(child->text(0)).append("_13_areas_60_min");
-            barSets.push_back(statisticsBarSet(offset,name));
+            checkedLabels.append(name);
+            checkedColumns.append(offset);
             child->setBackground(1,brushes.at(counter));
 
-            barSets.at(barSets.count()-1)->setBrush(brushes.at(counter));
+            checkedBrushes.append(brushes.at(counter));
             ++counter;
             counter = counter%brushes.count();
         }else{
@@ -903,10 +926,11 @@ void Statistics::plotStatistics(bool animation)
         const auto &child = skyCov_a25m60->child(i);
         if(child->checkState(0) == Qt::Checked){
             QString name = QString("sky-coverage_").append(child->text(0)).append("_25_areas_60_min");
-            barSets.push_back(statisticsBarSet(offset,name));
+            checkedLabels.append(name);
+            checkedColumns.append(offset);
             child->setBackground(1,brushes.at(counter));
 
-            barSets.at(barSets.count()-1)->setBrush(brushes.at(counter));
+            checkedBrushes.append(brushes.at(counter));
             ++counter;
             counter = counter%brushes.count();
         }else{
@@ -918,10 +942,11 @@ void Statistics::plotStatistics(bool animation)
         const auto &child = skyCov_a37m60->child(i);
         if(child->checkState(0) == Qt::Checked){
             QString name = QString("sky-coverage_").append(child->text(0)).append("_37_areas_60_min");
-            barSets.push_back(statisticsBarSet(offset,name));
+            checkedLabels.append(name);
+            checkedColumns.append(offset);
             child->setBackground(1,brushes.at(counter));
 
-            barSets.at(barSets.count()-1)->setBrush(brushes.at(counter));
+            checkedBrushes.append(brushes.at(counter));
             ++counter;
             counter = counter%brushes.count();
         }else{
@@ -935,10 +960,11 @@ void Statistics::plotStatistics(bool animation)
         const auto &child = staScans->child(i);
         if(child->checkState(0) == Qt::Checked){
             QString name = QString("n_sta_scans_").append(child->text(0));
-            barSets.push_back(statisticsBarSet(offset, name));
+            checkedLabels.append(name);
+            checkedColumns.append(offset);
             child->setBackground(1,brushes.at(counter));
 
-            barSets.at(barSets.count()-1)->setBrush(brushes.at(counter));
+            checkedBrushes.append(brushes.at(counter));
             ++counter;
             counter = counter%brushes.count();
         }else{
@@ -950,10 +976,11 @@ void Statistics::plotStatistics(bool animation)
         const auto &child = staObs->child(i);
         if(child->checkState(0) == Qt::Checked){
             QString name = QString("n_sta_obs_").append(child->text(0));
-            barSets.push_back(statisticsBarSet(offset, name));
+            checkedLabels.append(name);
+            checkedColumns.append(offset);
             child->setBackground(1,brushes.at(counter));
 
-            barSets.at(barSets.count()-1)->setBrush(brushes.at(counter));
+            checkedBrushes.append(brushes.at(counter));
             ++counter;
             counter = counter%brushes.count();
         }else{
@@ -966,10 +993,11 @@ void Statistics::plotStatistics(bool animation)
         const auto &child = blObs->child(i);
         if(child->checkState(0) == Qt::Checked){
             QString name = QString("n_bl_obs_").append(child->text(0));
-            barSets.push_back(statisticsBarSet(offset, name));
+            checkedLabels.append(name);
+            checkedColumns.append(offset);
             child->setBackground(1,brushes.at(counter));
 
-            barSets.at(barSets.count()-1)->setBrush(brushes.at(counter));
+            checkedBrushes.append(brushes.at(counter));
             ++counter;
             counter = counter%brushes.count();
         }else{
@@ -982,10 +1010,11 @@ void Statistics::plotStatistics(bool animation)
         const auto &child = srcScans->child(i);
         if(child->checkState(0) == Qt::Checked){
             QString name = QString("n_src_scans_").append(child->text(0));
-            barSets.push_back(statisticsBarSet(offset, name));
+            checkedLabels.append(name);
+            checkedColumns.append(offset);
             child->setBackground(1,brushes.at(counter));
 
-            barSets.at(barSets.count()-1)->setBrush(brushes.at(counter));
+            checkedBrushes.append(brushes.at(counter));
             ++counter;
             counter = counter%brushes.count();
         }else{
@@ -997,10 +1026,11 @@ void Statistics::plotStatistics(bool animation)
         const auto &child = srcObs->child(i);
         if(child->checkState(0) == Qt::Checked){
             QString name = QString("n_src_obs_").append(child->text(0));
-            barSets.push_back(statisticsBarSet(offset, name));
+            checkedLabels.append(name);
+            checkedColumns.append(offset);
             child->setBackground(1,brushes.at(counter));
 
-            barSets.at(barSets.count()-1)->setBrush(brushes.at(counter));
+            checkedBrushes.append(brushes.at(counter));
             ++counter;
             counter = counter%brushes.count();
         }else{
@@ -1013,10 +1043,11 @@ void Statistics::plotStatistics(bool animation)
         const auto &child = ms->child(i);
         if(child->checkState(0) == Qt::Checked){
             QString name = child->text(0);
-            barSets.push_back(statisticsBarSet(offset, name.replace(" ","_")));
+            checkedLabels.append(name.replace(" ","_"));
+            checkedColumns.append(offset);
             child->setBackground(1,brushes.at(counter));
 
-            barSets.at(barSets.count()-1)->setBrush(brushes.at(counter));
+            checkedBrushes.append(brushes.at(counter));
             ++counter;
             counter = counter%brushes.count();
         }else{
@@ -1032,10 +1063,11 @@ void Statistics::plotStatistics(bool animation)
             QString name = QString("sim_mean_formal_error_").append(child->text(0));
             name = name.replace("#","n_");
             name = name.replace(" ","_");
-            barSets.push_back(statisticsBarSet(offset, name));
+            checkedLabels.append(name);
+            checkedColumns.append(offset);
             child->setBackground(1,brushes.at(counter));
 
-            barSets.at(barSets.count()-1)->setBrush(brushes.at(counter));
+            checkedBrushes.append(brushes.at(counter));
             ++counter;
             counter = counter%brushes.count();
         }else{
@@ -1047,10 +1079,11 @@ void Statistics::plotStatistics(bool animation)
         const auto &child = simMeanFormalError_station->child(i);
         if(child->checkState(0) == Qt::Checked){
             QString name = QString("sim_mean_formal_error_").append(child->text(0));
-            barSets.push_back(statisticsBarSet(offset, name.replace(" ","_")));
+            checkedLabels.append(name.replace(" ","_"));
+            checkedColumns.append(offset);
             child->setBackground(1,brushes.at(counter));
 
-            barSets.at(barSets.count()-1)->setBrush(brushes.at(counter));
+            checkedBrushes.append(brushes.at(counter));
             ++counter;
             counter = counter%brushes.count();
         }else{
@@ -1066,10 +1099,11 @@ void Statistics::plotStatistics(bool animation)
             QString name = QString("sim_repeatability_").append(child->text(0));
             name = name.replace("#","n_");
             name = name.replace(" ","_");
-            barSets.push_back(statisticsBarSet(offset, name));
+            checkedLabels.append(name);
+            checkedColumns.append(offset);
             child->setBackground(1,brushes.at(counter));
 
-            barSets.at(barSets.count()-1)->setBrush(brushes.at(counter));
+            checkedBrushes.append(brushes.at(counter));
             ++counter;
             counter = counter%brushes.count();
         }else{
@@ -1081,10 +1115,11 @@ void Statistics::plotStatistics(bool animation)
         const auto &child = simRepeatability_station->child(i);
         if(child->checkState(0) == Qt::Checked){
             QString name = QString("sim_repeatability_").append(child->text(0));
-            barSets.push_back(statisticsBarSet(offset, name.replace(" ","_")));
+            checkedLabels.append(name.replace(" ","_"));
+            checkedColumns.append(offset);
             child->setBackground(1,brushes.at(counter));
 
-            barSets.at(barSets.count()-1)->setBrush(brushes.at(counter));
+            checkedBrushes.append(brushes.at(counter));
             ++counter;
             counter = counter%brushes.count();
         }else{
@@ -1095,117 +1130,81 @@ void Statistics::plotStatistics(bool animation)
 
 
 
-    // ################# create categories #################
-
-    QStringList categories;
-    for(const auto &key1: statistics.keys()){
-        for(const auto &key2: statistics[key1].keys()){
-            categories.push_back("v"+QString("%1 ").arg(key2)+key1);
-        }
-    }
-
     // ################# calculate score #################
 
-    QVector<double>score(categories.size(),0);
+    QVector<QPair<int, double>> weights;
 
     offset = 1;
     for(int i=0; i<gen->childCount(); ++i){
         const auto &child = gen->child(i);
-        double val = qobject_cast<QDoubleSpinBox*>(itemlist->itemWidget(child,2))->value();
+        double val = weight(child);
         if(val!=0){
-            auto data = statisticsBarSet(offset);
-            for(int id = 0; id<data->count(); ++id){
-                score[id] += data->at(id)*val;
-            }
+            weights.append(qMakePair(offset, val));
         }
         ++offset;
     }
     for(int i=0; i<time_avg->childCount(); ++i){
         const auto &child = time_avg->child(i);
-        double val = qobject_cast<QDoubleSpinBox*>(itemlist->itemWidget(child,2))->value();
+        double val = weight(child);
         if(val!=0){
-            auto data = statisticsBarSet(offset);
-            for(int id = 0; id<data->count(); ++id){
-                score[id] += data->at(id)*val;
-            }
+            weights.append(qMakePair(offset, val));
         }
         ++offset;
     }
     for(int i=0; i<skyCov_avg->childCount(); ++i){
         const auto &child = skyCov_avg->child(i);
-        double val = qobject_cast<QDoubleSpinBox*>(itemlist->itemWidget(child,2))->value();
+        double val = weight(child);
         if(val!=0){
-            auto data = statisticsBarSet(offset);
-            for(int id = 0; id<data->count(); ++id){
-                score[id] += data->at(id)*val;
-            }
+            weights.append(qMakePair(offset, val));
         }
         ++offset;
     }
 
     for(int i=0; i<wf->childCount(); ++i){
         const auto &child = wf->child(i);
-        double val = qobject_cast<QDoubleSpinBox*>(itemlist->itemWidget(child,2))->value();
+        double val = weight(child);
         if(val!=0){
-            auto data = statisticsBarSet(offset);
-            for(int id = 0; id<data->count(); ++id){
-                score[id] += data->at(id)*val;
-            }
+            weights.append(qMakePair(offset, val));
         }
         ++offset;
     }
     for(int i=0; i<time_obs->childCount(); ++i){
         const auto &child = time_obs->child(i);
-        double val = qobject_cast<QDoubleSpinBox*>(itemlist->itemWidget(child,2))->value();
+        double val = weight(child);
         if(val!=0){
-            auto data = statisticsBarSet(offset);
-            for(int id = 0; id<data->count(); ++id){
-                score[id] += data->at(id)*val;
-            }
+            weights.append(qMakePair(offset, val));
         }
         ++offset;
     }
     for(int i=0; i<time_preob->childCount(); ++i){
         const auto &child = time_preob->child(i);
-        double val = qobject_cast<QDoubleSpinBox*>(itemlist->itemWidget(child,2))->value();
+        double val = weight(child);
         if(val!=0){
-            auto data = statisticsBarSet(offset);
-            for(int id = 0; id<data->count(); ++id){
-                score[id] += data->at(id)*val;
-            }
+            weights.append(qMakePair(offset, val));
         }
         ++offset;
     }
     for(int i=0; i<time_slew->childCount(); ++i){
         const auto &child = time_slew->child(i);
-        double val = qobject_cast<QDoubleSpinBox*>(itemlist->itemWidget(child,2))->value();
+        double val = weight(child);
         if(val!=0){
-            auto data = statisticsBarSet(offset);
-            for(int id = 0; id<data->count(); ++id){
-                score[id] += data->at(id)*val;
-            }
+            weights.append(qMakePair(offset, val));
         }
         ++offset;
     }
     for(int i=0; i<time_idle->childCount(); ++i){
         const auto &child = time_idle->child(i);
-        double val = qobject_cast<QDoubleSpinBox*>(itemlist->itemWidget(child,2))->value();
+        double val = weight(child);
         if(val!=0){
-            auto data = statisticsBarSet(offset);
-            for(int id = 0; id<data->count(); ++id){
-                score[id] += data->at(id)*val;
-            }
+            weights.append(qMakePair(offset, val));
         }
         ++offset;
     }
     for(int i=0; i<time_field->childCount(); ++i){
         const auto &child = time_field->child(i);
-        double val = qobject_cast<QDoubleSpinBox*>(itemlist->itemWidget(child,2))->value();
+        double val = weight(child);
         if(val!=0){
-            auto data = statisticsBarSet(offset);
-            for(int id = 0; id<data->count(); ++id){
-                score[id] += data->at(id)*val;
-            }
+            weights.append(qMakePair(offset, val));
         }
         ++offset;
     }
@@ -1213,216 +1212,241 @@ void Statistics::plotStatistics(bool animation)
     // sky coverage
     for(int i=0; i<skyCov_a13m30->childCount(); ++i){
         const auto &child = skyCov_a13m30->child(i);
-        double val = qobject_cast<QDoubleSpinBox*>(itemlist->itemWidget(child,2))->value();
+        double val = weight(child);
         if(val!=0){
-            auto data = statisticsBarSet(offset);
-            for(int id = 0; id<data->count(); ++id){
-                score[id] += data->at(id)*val;
-            }
+            weights.append(qMakePair(offset, val));
         }
         ++offset;
     }
     for(int i=0; i<skyCov_a25m30->childCount(); ++i){
         const auto &child = skyCov_a25m30->child(i);
-        double val = qobject_cast<QDoubleSpinBox*>(itemlist->itemWidget(child,2))->value();
+        double val = weight(child);
         if(val!=0){
-            auto data = statisticsBarSet(offset);
-            for(int id = 0; id<data->count(); ++id){
-                score[id] += data->at(id)*val;
-            }
+            weights.append(qMakePair(offset, val));
         }
         ++offset;
     }
     for(int i=0; i<skyCov_a37m30->childCount(); ++i){
         const auto &child = skyCov_a37m30->child(i);
-        double val = qobject_cast<QDoubleSpinBox*>(itemlist->itemWidget(child,2))->value();
+        double val = weight(child);
         if(val!=0){
-            auto data = statisticsBarSet(offset);
-            for(int id = 0; id<data->count(); ++id){
-                score[id] += data->at(id)*val;
-            }
+            weights.append(qMakePair(offset, val));
         }
         ++offset;
     }
     for(int i=0; i<skyCov_a13m60->childCount(); ++i){
         const auto &child = skyCov_a13m60->child(i);
-        double val = qobject_cast<QDoubleSpinBox*>(itemlist->itemWidget(child,2))->value();
+        double val = weight(child);
         if(val!=0){
-            auto data = statisticsBarSet(offset);
-            for(int id = 0; id<data->count(); ++id){
-                score[id] += data->at(id)*val;
-            }
+            weights.append(qMakePair(offset, val));
         }
         ++offset;
     }
     for(int i=0; i<skyCov_a25m60->childCount(); ++i){
         const auto &child = skyCov_a25m60->child(i);
-        double val = qobject_cast<QDoubleSpinBox*>(itemlist->itemWidget(child,2))->value();
+        double val = weight(child);
         if(val!=0){
-            auto data = statisticsBarSet(offset);
-            for(int id = 0; id<data->count(); ++id){
-                score[id] += data->at(id)*val;
-            }
+            weights.append(qMakePair(offset, val));
         }
         ++offset;
     }
     for(int i=0; i<skyCov_a37m60->childCount(); ++i){
         const auto &child = skyCov_a37m60->child(i);
-        double val = qobject_cast<QDoubleSpinBox*>(itemlist->itemWidget(child,2))->value();
+        double val = weight(child);
         if(val!=0){
-            auto data = statisticsBarSet(offset);
-            for(int id = 0; id<data->count(); ++id){
-                score[id] += data->at(id)*val;
-            }
+            weights.append(qMakePair(offset, val));
         }
         ++offset;
     }
 
     for(int i=0; i<staScans->childCount(); ++i){
         const auto &child = staScans->child(i);
-        double val = qobject_cast<QDoubleSpinBox*>(itemlist->itemWidget(child,2))->value();
+        double val = weight(child);
         if(val!=0){
-            auto data = statisticsBarSet(offset);
-            for(int id = 0; id<data->count(); ++id){
-                score[id] += data->at(id)*val;
-            }
+            weights.append(qMakePair(offset, val));
         }
         ++offset;
     }
     for(int i=0; i<staObs->childCount(); ++i){
         const auto &child = staObs->child(i);
-        double val = qobject_cast<QDoubleSpinBox*>(itemlist->itemWidget(child,2))->value();
+        double val = weight(child);
         if(val!=0){
-            auto data = statisticsBarSet(offset);
-            for(int id = 0; id<data->count(); ++id){
-                score[id] += data->at(id)*val;
-            }
+            weights.append(qMakePair(offset, val));
         }
         ++offset;
     }
 
     for(int i=0; i<blObs->childCount(); ++i){
         const auto &child = blObs->child(i);
-        double val = qobject_cast<QDoubleSpinBox*>(itemlist->itemWidget(child,2))->value();
+        double val = weight(child);
         if(val!=0){
-            auto data = statisticsBarSet(offset);
-            for(int id = 0; id<data->count(); ++id){
-                score[id] += data->at(id)*val;
-            }
+            weights.append(qMakePair(offset, val));
         }
         ++offset;
     }
 
     for(int i=0; i<srcScans->childCount(); ++i){
         const auto &child = srcScans->child(i);
-        double val = qobject_cast<QDoubleSpinBox*>(itemlist->itemWidget(child,2))->value();
+        double val = weight(child);
         if(val!=0){
-            auto data = statisticsBarSet(offset);
-            for(int id = 0; id<data->count(); ++id){
-                score[id] += data->at(id)*val;
-            }
+            weights.append(qMakePair(offset, val));
         }
         ++offset;
     }
     for(int i=0; i<srcObs->childCount(); ++i){
         const auto &child = srcObs->child(i);
-        double val = qobject_cast<QDoubleSpinBox*>(itemlist->itemWidget(child,2))->value();
+        double val = weight(child);
         if(val!=0){
-            auto data = statisticsBarSet(offset);
-            for(int id = 0; id<data->count(); ++id){
-                score[id] += data->at(id)*val;
-            }
+            weights.append(qMakePair(offset, val));
         }
         ++offset;
     }
 
     for(int i=0; i<ms->childCount(); ++i){
         const auto &child = ms->child(i);
-        double val = qobject_cast<QDoubleSpinBox*>(itemlist->itemWidget(child,2))->value();
+        double val = weight(child);
         if(val!=0){
-            auto data = statisticsBarSet(offset);
-            for(int id = 0; id<data->count(); ++id){
-                score[id] += data->at(id)*val;
-            }
+            weights.append(qMakePair(offset, val));
         }
         ++offset;
     }
 
     for(int i=0; i<simMeanFormalError->childCount()-1; ++i){
         const auto &child = simMeanFormalError->child(i);
-        double val = qobject_cast<QDoubleSpinBox*>(itemlist->itemWidget(child,2))->value();
+        double val = weight(child);
         if(val!=0){
-            auto data = statisticsBarSet(offset);
-            for(int id = 0; id<data->count(); ++id){
-                score[id] += data->at(id)*val;
-            }
+            weights.append(qMakePair(offset, val));
         }
         ++offset;
     }
     for(int i=0; i<simMeanFormalError_station->childCount(); ++i){
         const auto &child = simMeanFormalError_station->child(i);
-        double val = qobject_cast<QDoubleSpinBox*>(itemlist->itemWidget(child,2))->value();
+        double val = weight(child);
         if(val!=0){
-            auto data = statisticsBarSet(offset);
-            for(int id = 0; id<data->count(); ++id){
-                score[id] += data->at(id)*val;
-            }
+            weights.append(qMakePair(offset, val));
         }
         ++offset;
     }
 
     for(int i=0; i<simRepeatability->childCount()-1; ++i){
         const auto &child = simRepeatability->child(i);
-        double val = qobject_cast<QDoubleSpinBox*>(itemlist->itemWidget(child,2))->value();
+        double val = weight(child);
         if(val!=0){
-            auto data = statisticsBarSet(offset);
-            for(int id = 0; id<data->count(); ++id){
-                score[id] += data->at(id)*val;
-            }
+            weights.append(qMakePair(offset, val));
         }
         ++offset;
     }
     for(int i=0; i<simRepeatability_station->childCount(); ++i){
         const auto &child = simRepeatability_station->child(i);
-        double val = qobject_cast<QDoubleSpinBox*>(itemlist->itemWidget(child,2))->value();
+        double val = weight(child);
         if(val!=0){
-            auto data = statisticsBarSet(offset);
-            for(int id = 0; id<data->count(); ++id){
-                score[id] += data->at(id)*val;
-            }
+            weights.append(qMakePair(offset, val));
         }
         ++offset;
     }
 
+    scoreWeights = weights;
+    score = StatisticsScore::weightedScore(statistics, weights, removeMinimum->isChecked(), relative->isChecked());
+
     // ################# sort bars #################
 
     QVector<int> idx(score.size());
     std::iota(idx.begin(), idx.end(), 0);
-    std::stable_sort(idx.begin(), idx.end(),[&score](int i1, int i2) {return score[i1] > score[i2];});
+    std::stable_sort(idx.begin(), idx.end(),[this](int i1, int i2) {return score[i1] > score[i2];});
+    sortedRows = idx;
+
+    // ################# prepare visible bars #################
+
+    checkedOffsets.clear();
+    checkedScales.clear();
+    double yMin = 0;
+    double yMax = 0;
+    for(int i=0; i<checkedColumns.count(); ++i){
+        int col = checkedColumns.at(i);
+        double colOffset = 0;
+        double colScale = 0;
+        if(col < statistics.columnCount()){
+            StatisticsScore::columnTransformation(statistics, col, removeMinimum->isChecked(), relative->isChecked(), colOffset, colScale);
+            const double *v = statistics.column(col);
+            for(int row=0; row<statistics.rowCount(); ++row){
+                double value = (v[row]-colOffset)*colScale;
+                yMin = std::min(yMin, value);
+                yMax = std::max(yMax, value);
+            }
+        }
+        checkedOffsets.append(colOffset);
+        checkedScales.append(colScale);
+    }
+    if(yMax == yMin){
+        yMax = yMin+1;
+    }
+    statisticsYMin = yMin;
+    statisticsYMax = yMax;
+
+    updateStatisticsScrollBar();
+    plotStatisticsWindow(animation);
+    itemlist->blockSignals(false);
+
+    updateRanking();
 
-    QStringList sortedCategories;
-    for(int i=0; i<idx.count(); ++i){
-        sortedCategories << categories.at(idx.at(i));
+    }catch(...){
+        QMessageBox::warning(this,"keep it slow!","A Error occured! Maybe because you canged too many values too fast!");
+        itemlist->blockSignals(false);
     }
-    QBarSeries* sortedSeries = new QBarSeries();
-    for(int i=0; i<barSets.count(); ++i){
-        auto thisBarSet = barSets.at(i);
-        QBarSet *sortedBarSet = new QBarSet(thisBarSet->label());
-        sortedBarSet->setBrush(thisBarSet->brush());
-        for(int j = 0; j<thisBarSet->count(); ++j){
-            auto thisValue = thisBarSet->at(idx.at(j));
-            *sortedBarSet << thisValue;
+
+}
+
+void Statistics::updateStatisticsScrollBar()
+{
+    int showN = show->value();
+    scrollBar->blockSignals(true);
+    if(sortedRows.count()>showN){
+        scrollBar->setRange(0,sortedRows.size()-showN);
+        scrollBar->setSingleStep(1);
+    }else{
+        scrollBar->setRange(0,0);
+        scrollBar->setSingleStep(1);
+    }
+    scrollBar->blockSignals(false);
+}
+
+void Statistics::plotStatisticsWindow(bool animation)
+{
+    int first = std::max(0, std::min(scrollBar->value(), sortedRows.size()));
+    int last = std::min(first+show->value(), sortedRows.size());
+    windowStart = first;
+
+    QStringList categories;
+    for(int i=first; i<last; ++i){
+        int row = sortedRows.at(i);
+        categories << "v"+QString("%1 ").arg(statistics.version(row))+statistics.folder(row);
+    }
+
+    QBarSeries* series = new QBarSeries();
+    for(int i=0; i<checkedLabels.count(); ++i){
+        QBarSet *set = new QBarSet(checkedLabels.at(i));
+        set->setBrush(checkedBrushes.at(i));
+        int col = checkedColumns.at(i);
+        if(col < statistics.columnCount()){
+            const double *v = statistics.column(col);
+            double colOffset = checkedOffsets.at(i);
+            double colScale = checkedScales.at(i);
+            for(int j=first; j<last; ++j){
+                *set << (v[sortedRows.at(j)]-colOffset)*colScale;
+            }
+        }else{
+            for(int j=first; j<last; ++j){
+                *set << 0;
+            }
         }
-        sortedSeries->append(sortedBarSet);
-        delete(thisBarSet);
+        series->append(set);
     }
 
     // ################# plot #################
 
-
     QChart *chart = statisticsView->chart();
     chart->removeAllSeries();
-    chart->addSeries(sortedSeries);
+    chart->addSeries(series);
     chart->setTitle("statistics");
     if(animation){
         chart->setAnimationOptions(QChart::SeriesAnimations);
@@ -1433,61 +1457,92 @@ void Statistics::plotStatistics(bool animation)
     chart->legend()->setVisible(false);
 
     QBarCategoryAxis *axis = new QBarCategoryAxis();
-    axis->append(sortedCategories);
+    axis->append(categories);
     chart->createDefaultAxes();
-    chart->setAxisX(axis, sortedSeries);
-    sortedSeries->attachAxis(chart->axisY());
-    static_cast<QValueAxis *>(chart->axisY())->applyNiceNumbers();
-
-    int showN = show->value();
-
-    if(!sortedCategories.isEmpty()){
-        QString minax = sortedCategories.at(0);
-        QString maxax;
-        if(sortedCategories.count()>showN){
-            maxax = sortedCategories.at(showN-1);
-        }else{
-            maxax = sortedCategories.at(sortedCategories.size()-1);
-        }
-        axis->setMin(minax);
-        axis->setMax(maxax);
-    }
-
+    chart->setAxisX(axis, series);
+    series->attachAxis(chart->axisY());
+    // same y range for all windows
+    auto yAxis = static_cast<QValueAxis *>(chart->axisY());
+    yAxis->setRange(statisticsYMin, statisticsYMax);
+    yAxis->applyNiceNumbers();
 
     statisticsView->setRenderHint(QPainter::Antialiasing);
 
-    if(categories.count()>showN){
-        scrollBar->setRange(0,categories.size()-showN);
-        scrollBar->setSingleStep(1);
+    connect(series,SIGNAL(hovered(bool,int,QBarSet*)),this,SLOT(statisticsHovered(bool,int,QBarSet*)));
+}
+
+void Statistics::updateRanking()
+{
+    QVector<int> rows;
+    if(rankingPareto){
+        QVector<QPair<int, bool>> criteria;
+        for(int col : checkedColumns){
+            bool largerIsBetter = true;
+            for(const auto &any : scoreWeights){
+                if(any.first == col){
+                    largerIsBetter = any.second >= 0;
+                    break;
+                }
+            }
+            criteria.append(qMakePair(col, largerIsBetter));
+        }
+        rows = StatisticsScore::paretoFront(statistics, criteria);
+        std::stable_sort(rows.begin(), rows.end(), [this](int i1, int i2) {return score[i1] > score[i2];});
+        rankingBox->setTitle(QString("ranking: Pareto front over %1 statistics (%2 versions)").arg(criteria.size()).arg(rows.size()));
     }else{
-        scrollBar->setRange(0,0);
-        scrollBar->setSingleStep(1);
-    }
+        rows = StatisticsScore::topK(score, rankingTopK->value());
+        rankingBox->setTitle(QString("ranking: top %1 versions").arg(rows.size()));
+    }
+
+    rankingTree->clear();
+    QList<QTreeWidgetItem *> items;
+    for(int i=0; i<rows.size(); ++i){
+        int row = rows.at(i);
+        auto itm = new QTreeWidgetItem(QStringList() << QString::number(i+1)
+                                                      << QString::number(statistics.version(row))
+                                                      << statistics.folder(row)
+                                                      << QString::number(score.at(row)));
+        itm->setData(0, Qt::UserRole, row);
+        items.append(itm);
+    }
+    rankingTree->addTopLevelItems(items);
+}
 
-    connect(sortedSeries,SIGNAL(hovered(bool,int,QBarSet*)),this,SLOT(statisticsHovered(bool,int,QBarSet*)));
-    itemlist->blockSignals(false);
+void Statistics::on_spinBox_rankingTopK_valueChanged()
+{
+    rankingPareto = false;
+    updateRanking();
+}
 
-    }catch(...){
-        QMessageBox::warning(this,"keep it slow!","A Error occured! Maybe because you canged too many values too fast!");
-        itemlist->blockSignals(false);
+void Statistics::on_pushButton_paretoFront_clicked()
+{
+    if(checkedColumns.isEmpty()){
+        QMessageBox::information(this,"Pareto front","Check the statistics which should be used as criteria first!");
+        return;
     }
+    rankingPareto = true;
+    updateRanking();
+}
 
+void Statistics::rankingItemDoubleClicked(QTreeWidgetItem *item)
+{
+    int pos = sortedRows.indexOf(item->data(0, Qt::UserRole).toInt());
+    if(pos != -1){
+        scrollBar->setValue(std::min(pos, scrollBar->maximum()));
+    }
 }
 
 void Statistics::statisticsHovered(bool status, int index, QBarSet *barset)
 {
     if (status) {
 
-        auto axis = qobject_cast<QBarCategoryAxis*>(statisticsView->chart()->axisX());
-        auto categories = axis->categories();
-        QString catName = categories.at(index);
-        QStringList splitCatName = catName.split(" ");
-        int version = splitCatName.at(0).right(splitCatName.at(0).count()-1).toInt();
-        QString name = splitCatName.at(1);
+        int row = sortedRows.at(windowStart+index);
+        int version = statistics.version(row);
+        QString name = statistics.folder(row);
         double value = 0;
 
         QString fullLabel = barset->label();
-        int idx = lookupTable.indexOf(fullLabel);
+        int idx = statistics.columnIndex(fullLabel);
         QString label = fullLabel;
         if(fullLabel.left(2) == "n_"){
             label = QString("#").append(fullLabel.mid(2));
@@ -1501,7 +1556,9 @@ void Statistics::statisticsHovered(bool status, int index, QBarSet *barset)
         if(label.left(4) == "time"){
             label.append(" [%]");
         }
-        value = statistics[name][version][idx];
+        if(idx != -1){
+            value = statistics.value(row, idx);
+        }
 
         hoveredTitle->setText(label);
         hovered->clear();
@@ -1514,45 +1571,31 @@ void Statistics::statisticsHovered(bool status, int index, QBarSet *barset)
     }
 }
 
-QBarSet *Statistics::statisticsBarSet(int idx, QString name)
+void Statistics::addWeight(QTreeWidgetItem *item)
 {
+    item->setFlags(item->flags() | Qt::ItemIsEditable);
+    item->setData(2, Qt::EditRole, 0.0);
+}
 
-    QVector<double> v;
-    for(const auto &key1: statistics.keys()){
-        for(const auto &key2: statistics[key1].keys()){
-            if(idx >= statistics[key1][key2].count()){
-                v << 0;
-            }else{
-                v << statistics[key1][key2][idx];
-            }
-        }
-    }
-
-    if(removeMinimum->isChecked()){
-        double min = *std::min_element(v.begin(), v.end());
-        for(int i=0; i<v.count(); ++i){
-            v[i] -= min;
-        }
-    }
-
-    if(relative->isChecked()){
-        double max = *std::max_element(v.begin(), v.end());
-        for(int i=0; i<v.count(); ++i){
-            v[i] /= max;
-        }
-    }
+double Statistics::weight(QTreeWidgetItem *item) const
+{
+    return item->data(2, Qt::EditRole).toDouble();
+}
 
-    QBarSet *set = new QBarSet(name);
-    for(int i=0; i<v.count(); ++i){
-        *set << v.at(i);
+void Statistics::editWeight(QTreeWidgetItem *item, int column)
+{
+    if(column == 2 && item->data(2, Qt::EditRole).isValid()){
+        itemlist->editItem(item, 2);
     }
-
-    return set;
 }
 
-
 void Statistics::on_treeWidget_statisticGeneral_itemChanged(QTreeWidgetItem *item, int column)
 {
+    if(column == 2){
+        scoreTimer->start();
+        return;
+    }
+
     itemlist->blockSignals(true);
 
     if(item->checkState(0) == Qt::PartiallyChecked){
@@ -1635,26 +1678,20 @@ void Statistics::on_treeWidget_statisticGeneral_itemChanged(QTreeWidgetItem *ite
 
 void Statistics::on_horizontalScrollBar_statistics_valueChanged(int value)
 {
-
-    statisticsView->chart()->setAnimationOptions(QChart::NoAnimation);
+    Q_UNUSED(value);
     hoveredTitle->setText("hovered item");
     hovered->clear();
 
-    auto axis = qobject_cast<QBarCategoryAxis*>(statisticsView->chart()->axisX());
-    auto categories = axis->categories();
-    if(!categories.isEmpty()){
-        QString min = categories.at(value);
-        QString max = categories.at(value+show->value()-1);
-        axis->setMin(min);
-        axis->setMax(max);
-        axis->setMin(min);
-    }
+    plotStatisticsWindow(false);
 }
 
 void Statistics::on_spinBox_statistics_show_valueChanged(int arg1)
 {
+    Q_UNUSED(arg1);
     hoveredTitle->setText("hovered item");
     hovered->clear();
 
-    plotStatistics(false);
+    // ranking and scaling do not depend on the number of visible versions, only the window is rebuilt
+    updateStatisticsScrollBar();
+    plotStatisticsWindow(false);
 }
@@ -13,7 +13,14 @@
 #include <QFileDialog>
 #include <QMessageBox>
 #include <QLineEdit>
+#include <QGroupBox>
+#include <QPushButton>
 #include <QTextStream>
+#include <QProgressDialog>
+#include <QFutureWatcher>
+#include <QFileSystemWatcher>
+#include <QTimer>
+#include <QtConcurrent/QtConcurrentMap>
 
 #include <QtCharts/QChart>
 #include <QtCharts/QChartView>
@@ -22,6 +29,10 @@
 #include <QtCharts/QBarCategoryAxis>
 #include <QtCharts/QValueAxis>
 
+#include "Delegates/doublespinboxdelegate.h"
+#include "statisticsmatrix.h"
+#include "statisticsscore.h"
+
 QT_CHARTS_USE_NAMESPACE
 
 class Statistics : public QWidget
@@ -37,6 +48,7 @@ public:
             QSpinBox *show,
             QListWidget *statisticsCSV,
             QCheckBox *removeMinimum,
+            QCheckBox *follow,
             QRadioButton *relative,
             QRadioButton *absolute,
             QLineEdit *outputPath);
@@ -64,6 +76,7 @@ private:
     QSpinBox *show;
     QListWidget *statisticsCSV;
     QCheckBox *removeMinimum;
+    QCheckBox *follow;
     QRadioButton *relative;
     QRadioButton *absolute;
     QLineEdit *outputPath;
@@ -76,20 +89,61 @@ private:
     QStringList sources;
     QStringList times;
     QStringList multiScheduling;
-    QStringList lookupTable;
-    QMap<QString, QMap<int, QVector< double >>> statistics;
+    StatisticsMatrix statistics;
+    QVector<int> sortedRows;
+    QVector<double> score;
+    QVector<QPair<int, double>> scoreWeights;
+    QVector<int> checkedColumns;
+    QStringList checkedLabels;
+    QVector<QBrush> checkedBrushes;
+    QVector<double> checkedOffsets;
+    QVector<double> checkedScales;
+    double statisticsYMin;
+    double statisticsYMax;
+    int windowStart;
+    QFutureWatcher<StatisticsMatrix::Block> *loadWatcher;
+    QProgressDialog *loadProgress;
+    QFileSystemWatcher *fileWatcher;
+    QTimer *followTimer;
+    QTimer *scoreTimer;
+    QGroupBox *rankingBox;
+    QSpinBox *rankingTopK;
+    QTreeWidget *rankingTree;
+    bool rankingPareto;
+
+    void reload();
 
-    void addEmptyStatistic(int idx);
+    void addWeight(QTreeWidgetItem *item);
 
-    QBarSet* statisticsBarSet(int idx, QString name="");
+    double weight(QTreeWidgetItem *item) const;
 
-    void reload();
+    void updateStatisticsScrollBar();
 
 private slots:
+    void statisticsLoaded();
+
+    void editWeight(QTreeWidgetItem *item, int column);
+
+    void on_checkBox_statistics_follow_toggled(bool checked);
+
+    void statisticsFileChanged(const QString &path);
+
+    void followStatistics();
+
     void plotStatistics(bool animation = false);
 
+    void plotStatisticsWindow(bool animation = false);
+
     void statisticsHovered(bool status, int index, QBarSet* barset);
 
+    void updateRanking();
+
+    void on_spinBox_rankingTopK_valueChanged();
+
+    void on_pushButton_paretoFront_clicked();
+
+    void rankingItemDoubleClicked(QTreeWidgetItem *item);
+
 };
 
 #endif // STATISTICS_H
@@ -0,0 +1,714 @@
+/*
+ *  VieSched++ Very Long Baseline Interferometry (VLBI) Scheduling Software
+ *  Copyright (C) 2018  Matthias Schartner
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "statisticsmatrix.h"
+
+#include <QFileInfo>
+#include <QDir>
+#include <QDateTime>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QCryptographicHash>
+#include <QPair>
+
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+#include <limits>
+
+namespace {
+
+    /**
+     * @brief fixed size header of a statistics cache file
+     *
+     * followed by the file path (UTF-8), the comma separated header (UTF-8), the version numbers (qint32) and the
+     * column-major values (double). Each section starts at a multiple of 8 bytes.
+     */
+    struct CacheHeader{
+        char magic[8];
+        qint64 sourceSize;
+        qint64 sourceMTime;
+        qint64 parsedBytes;
+        qint32 partialRow;
+        qint32 nRows;
+        qint32 nColumns;
+        qint32 pathBytes;
+        qint32 headerBytes;
+        qint32 reserved;
+    };
+
+    const char cacheMagic[8] = {'V','S','S','T','A','T','0','1'};
+
+    // upper limit of values per block and of the merged matrix (16 GB), larger files are rejected
+    const qint64 maxValues = std::numeric_limits<qint32>::max();
+
+    // upper limit of the statistics cache directory, least recently written entries are removed first
+    const qint64 maxCacheBytes = qint64(1) << 30;
+
+    qint64 align8(qint64 n){
+        return (n + 7) & ~qint64(7);
+    }
+
+    /**
+     * @brief path of the statistics file a cache file belongs to
+     *
+     * @param cache cache file
+     * @return absolute path of statistics file or empty string if the cache file is invalid
+     */
+    QString cachedSourcePath(const QString &cache){
+        QFile file(cache);
+        CacheHeader h;
+        if(!file.open(QIODevice::ReadOnly) ||
+                file.read(reinterpret_cast<char *>(&h), sizeof(CacheHeader)) != static_cast<qint64>(sizeof(CacheHeader)) ||
+                memcmp(h.magic, cacheMagic, sizeof(cacheMagic)) != 0 ||
+                h.pathBytes <= 0 || align8(sizeof(CacheHeader)) + h.pathBytes > file.size() ||
+                !file.seek(align8(sizeof(CacheHeader)))){
+            return QString();
+        }
+        QByteArray path = file.read(h.pathBytes);
+        if(path.size() != h.pathBytes){
+            return QString();
+        }
+        return QString::fromUtf8(path);
+    }
+}
+
+StatisticsMatrix::StatisticsMatrix()
+{
+    nRows_ = 0;
+    stride_ = 0;
+}
+
+void StatisticsMatrix::clear()
+{
+    header_.clear();
+    index_.clear();
+    files_.clear();
+    rowFile_.clear();
+    versions_.clear();
+    std::vector<double>().swap(data_);
+    nRows_ = 0;
+    stride_ = 0;
+}
+
+StatisticsMatrix::Block StatisticsMatrix::parseFile(const QString &path)
+{
+    Block block;
+    block.path = path;
+    block.folder = QFileInfo(path).dir().dirName();
+
+    QFileInfo info(path);
+    qint64 size = info.size();
+    qint64 mtime = info.lastModified().toMSecsSinceEpoch();
+    if(size > 0 && readCache(path, size, mtime, block)){
+        return block;
+    }
+
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        block.error = file.errorString();
+        return block;
+    }
+    if(file.size() == 0){
+        return block;
+    }
+
+    const char *begin = reinterpret_cast<const char *>(file.map(0, file.size()));
+    if(begin == nullptr){
+        block.error = file.errorString();
+        return block;
+    }
+    const char *end = begin + file.size();
+
+    // the header is only complete once its newline arrived, until then the file is treated as empty and
+    // readAppended reads it again
+    const char *eol = static_cast<const char *>(memchr(begin, '\n', end-begin));
+    if(eol == nullptr){
+        return block;
+    }
+    block.header = splitHeader(begin, eol);
+
+    const char *body = eol+1;
+    int nRows = countRows(body, end);
+    if(!allocate(nRows, block)){
+        return block;
+    }
+    parseRows(body, end, block);
+    findLastLine(body, end, body-begin, block);
+
+    if(file.size() == size){
+        writeCache(block, size, mtime);
+    }
+
+    return block;
+}
+
+bool StatisticsMatrix::merge(const QVector<Block> &blocks, QString &errorPath, QString &errorMessage)
+{
+    clear();
+
+    // ################# unify header #################
+    QVector<QVector<int>> columnMaps;
+    qint64 nRows = 0;
+    for(const auto &block : blocks){
+        if(!block.error.isEmpty()){
+            errorPath = block.path;
+            errorMessage = block.error;
+            clear();
+            return false;
+        }
+
+        QVector<int> columnMap;
+        for(const auto &name : block.header){
+            int idx = index_.value(name, -1);
+            if(idx == -1){
+                idx = header_.size();
+                header_.append(name);
+                index_.insert(name, idx);
+            }
+            columnMap.append(idx);
+        }
+        columnMaps.append(columnMap);
+        nRows += block.versions.size();
+        if(nRows > std::numeric_limits<int>::max() || nRows*header_.size() > maxValues){
+            errorPath = block.path;
+            errorMessage = QString("too many values (%1 versions, %2 columns)").arg(nRows).arg(header_.size());
+            clear();
+            return false;
+        }
+    }
+    nRows_ = static_cast<int>(nRows);
+
+    // ################# row order #################
+    // rows are sorted by session folder and version (order of the former per-folder version map),
+    // rows which are added later in follow mode are appended at the end
+    QVector<QPair<int, int>> order;
+    order.reserve(nRows_);
+    for(int i=0; i<blocks.size(); ++i){
+        for(int r=0; r<blocks.at(i).versions.size(); ++r){
+            order.append(qMakePair(i, r));
+        }
+    }
+    std::stable_sort(order.begin(), order.end(), [&blocks](const QPair<int, int> &a, const QPair<int, int> &b){
+        const QString &fa = blocks.at(a.first).folder;
+        const QString &fb = blocks.at(b.first).folder;
+        if(fa != fb){
+            return fa < fb;
+        }
+        return blocks.at(a.first).versions.at(a.second) < blocks.at(b.first).versions.at(b.second);
+    });
+    QVector<QVector<int>> targetRow(blocks.size());
+    for(int i=0; i<blocks.size(); ++i){
+        targetRow[i].resize(blocks.at(i).versions.size());
+    }
+    versions_.resize(nRows_);
+    rowFile_.resize(nRows_);
+    for(int row=0; row<order.size(); ++row){
+        const auto &any = order.at(row);
+        targetRow[any.first][any.second] = row;
+        versions_[row] = blocks.at(any.first).versions.at(any.second);
+        rowFile_[row] = any.first;
+    }
+
+    // ################# copy values #################
+    stride_ = nRows_;
+    data_.assign(static_cast<size_t>(stride_)*header_.size(), 0.0);
+    for(int i=0; i<blocks.size(); ++i){
+        const auto &block = blocks.at(i);
+        int n = block.versions.size();
+        const QVector<int> &columnMap = columnMaps.at(i);
+        const QVector<int> &target = targetRow.at(i);
+        for(int c=0; c<columnMap.size(); ++c){
+            const double *src = block.data.data() + static_cast<size_t>(c)*n;
+            double *dst = data_.data() + static_cast<size_t>(columnMap.at(c))*stride_;
+            for(int r=0; r<n; ++r){
+                dst[target.at(r)] = src[r];
+            }
+        }
+
+        File file;
+        file.path = block.path;
+        file.folder = block.folder;
+        file.header = block.header;
+        file.parsedBytes = block.parsedBytes;
+        file.partialRow = block.partialRow && n > 0 ? target.at(n-1) : -1;
+        files_.append(file);
+    }
+
+    return true;
+}
+
+void StatisticsMatrix::removeColumns(const QVector<char> &keep)
+{
+    int nColumns = 0;
+    QStringList header;
+    for(int c=0; c<header_.size(); ++c){
+        if(c < keep.size() && !keep.at(c)){
+            continue;
+        }
+        if(c != nColumns){
+            // destination is always in front of the source, a forward copy is safe
+            auto src = data_.begin() + static_cast<size_t>(c)*stride_;
+            std::copy(src, src+stride_, data_.begin() + static_cast<size_t>(nColumns)*stride_);
+        }
+        header.append(header_.at(c));
+        ++nColumns;
+    }
+    if(nColumns == header_.size()){
+        return;
+    }
+
+    data_.resize(static_cast<size_t>(nColumns)*stride_);
+    header_ = header;
+    index_.clear();
+    for(int c=0; c<header_.size(); ++c){
+        index_.insert(header_.at(c), c);
+    }
+}
+
+int StatisticsMatrix::readAppended(int fileIdx)
+{
+    File &f = files_[fileIdx];
+
+    QFile file(f.path);
+    if (!file.open(QIODevice::ReadOnly) || file.size() < f.parsedBytes) {
+        return -1;
+    }
+    qint64 size = file.size() - f.parsedBytes;
+    if(size == 0){
+        return 0;
+    }
+    const char *begin = reinterpret_cast<const char *>(file.map(f.parsedBytes, size));
+    if(begin == nullptr){
+        return -1;
+    }
+    const char *end = begin + size;
+
+    // a file which was loaded without complete header has parsedBytes 0, its header is merged once the newline arrived
+    qint64 offset = f.parsedBytes;
+    if(f.parsedBytes == 0){
+        const char *eol = static_cast<const char *>(memchr(begin, '\n', end-begin));
+        if(eol == nullptr){
+            return 0;
+        }
+        f.header = splitHeader(begin, eol);
+        if(!addColumns(f.header)){
+            return -1;
+        }
+        offset = eol+1 - begin;
+        begin = eol+1;
+    }
+
+    Block block;
+    block.header = f.header;
+    int n = countRows(begin, end);
+    if(!allocate(n, block)){
+        return -1;
+    }
+    parseRows(begin, end, block);
+    findLastLine(begin, end, offset, block);
+    if(n == 0){
+        f.parsedBytes = block.parsedBytes;
+        return 0;
+    }
+
+    // parsing started at the beginning of the incomplete row, therefore the first row replaces it
+    QVector<int> targetRow(n);
+    int nNew = 0;
+    for(int r=0; r<n; ++r){
+        if(r == 0 && f.partialRow != -1){
+            targetRow[r] = f.partialRow;
+        }else{
+            targetRow[r] = nRows_ + nNew;
+            ++nNew;
+        }
+    }
+    if(!reserveRows(nRows_ + nNew)){
+        return -1;
+    }
+    versions_.resize(nRows_ + nNew);
+    rowFile_.resize(nRows_ + nNew);
+
+    for(int c=0; c<block.header.size(); ++c){
+        int col = index_.value(block.header.at(c), -1);
+        if(col == -1){
+            continue;
+        }
+        const double *src = block.data.data() + static_cast<size_t>(c)*n;
+        double *dst = data_.data() + static_cast<size_t>(col)*stride_;
+        for(int r=0; r<n; ++r){
+            dst[targetRow.at(r)] = src[r];
+        }
+    }
+    for(int r=0; r<n; ++r){
+        versions_[targetRow.at(r)] = block.versions.at(r);
+        rowFile_[targetRow.at(r)] = fileIdx;
+    }
+
+    nRows_ += nNew;
+    f.parsedBytes = block.parsedBytes;
+    f.partialRow = block.partialRow ? targetRow.at(n-1) : -1;
+
+    return n;
+}
+
+bool StatisticsMatrix::reserveRows(int n)
+{
+    if(n <= stride_){
+        return true;
+    }
+    qint64 limit = std::numeric_limits<int>::max();
+    if(!header_.isEmpty()){
+        limit = std::min(limit, maxValues/header_.size());
+    }
+    if(n > limit){
+        return false;
+    }
+
+    // grow geometrically so that following a file which grows version by version stays linear
+    int stride = static_cast<int>(std::min(std::max<qint64>(n, stride_ + static_cast<qint64>(stride_)/2), limit));
+    std::vector<double> data(static_cast<size_t>(stride)*header_.size(), 0.0);
+    for(int c=0; c<header_.size(); ++c){
+        const double *src = data_.data() + static_cast<size_t>(c)*stride_;
+        std::copy(src, src+nRows_, data.begin() + static_cast<size_t>(c)*stride);
+    }
+    data_.swap(data);
+    stride_ = stride;
+    return true;
+}
+
+bool StatisticsMatrix::addColumns(const QStringList &names)
+{
+    for(const auto &name : names){
+        if(index_.contains(name)){
+            continue;
+        }
+        if(static_cast<qint64>(header_.size()+1)*stride_ > maxValues){
+            return false;
+        }
+        // values are column-major, a new column is appended behind the existing ones
+        index_.insert(name, header_.size());
+        header_.append(name);
+        data_.resize(static_cast<size_t>(header_.size())*stride_, 0.0);
+    }
+    return true;
+}
+
+bool StatisticsMatrix::allocate(int nRows, Block &block)
+{
+    qint64 nValues = static_cast<qint64>(nRows)*block.header.size();
+    if(nValues > maxValues){
+        block.error = QString("too many values (%1 versions, %2 columns)").arg(nRows).arg(block.header.size());
+        return false;
+    }
+    block.versions.fill(0, nRows);
+    block.data.assign(static_cast<size_t>(nValues), 0.0);
+    return true;
+}
+
+QStringList StatisticsMatrix::splitHeader(const char *begin, const char *end)
+{
+    if(begin == nullptr){
+        return QStringList();
+    }
+    if(end > begin && end[-1] == '\r'){
+        --end;
+    }
+    return QString::fromLatin1(begin, static_cast<int>(end-begin)).split(",",QString::SplitBehavior::SkipEmptyParts);
+}
+
+int StatisticsMatrix::countRows(const char *begin, const char *end)
+{
+    int n = 0;
+    const char *p = begin;
+    while(p < end){
+        const char *eol = static_cast<const char *>(memchr(p, '\n', end-p));
+        if(eol == nullptr){
+            eol = end;
+        }
+        const char *lineEnd = eol;
+        if(lineEnd > p && lineEnd[-1] == '\r'){
+            --lineEnd;
+        }
+        if(lineEnd > p){
+            ++n;
+        }
+        p = eol+1;
+    }
+    return n;
+}
+
+double StatisticsMatrix::parseDouble(const char *begin, const char *end)
+{
+    // exactly representable powers of ten
+    static const double powersOf10[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                                        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+    const char *p = begin;
+    while(p != end && (*p == ' ' || *p == '\t')){
+        ++p;
+    }
+    if(p == end){
+        return 0;
+    }
+
+    bool negative = false;
+    if(*p == '-' || *p == '+'){
+        negative = *p == '-';
+        ++p;
+    }
+
+    // accumulate the digits as integer mantissa and keep track of the decimal exponent
+    double mantissa = 0;
+    int exponent = 0;
+    int significant = 0;
+    bool digits = false;
+    while(p != end && *p >= '0' && *p <= '9'){
+        mantissa = mantissa*10 + (*p - '0');
+        if(significant > 0 || *p != '0'){
+            ++significant;
+        }
+        digits = true;
+        ++p;
+    }
+    if(p != end && *p == '.'){
+        ++p;
+        while(p != end && *p >= '0' && *p <= '9'){
+            mantissa = mantissa*10 + (*p - '0');
+            if(significant > 0 || *p != '0'){
+                ++significant;
+            }
+            --exponent;
+            digits = true;
+            ++p;
+        }
+    }
+    if(digits && p != end && (*p == 'e' || *p == 'E')){
+        ++p;
+        bool negativeExponent = false;
+        if(p != end && (*p == '-' || *p == '+')){
+            negativeExponent = *p == '-';
+            ++p;
+        }
+        int e = 0;
+        while(p != end && *p >= '0' && *p <= '9'){
+            e = std::min(e*10 + (*p - '0'), 100000);
+            ++p;
+        }
+        exponent += negativeExponent ? -e : e;
+    }
+    while(p != end && (*p == ' ' || *p == '\t')){
+        ++p;
+    }
+
+    // With at most 15 significant digits the mantissa is an exact integer below 2^53 and 10^|exponent| is exact for
+    // |exponent| <= 22, so a single multiplication or division is correctly rounded. Everything else (long mantissas,
+    // large exponents, nan, inf, ...) is converted by Qt, which is correctly rounded and independent of the C locale.
+    if(!digits || p != end || significant > 15 || exponent < -22 || exponent > 22){
+        return QByteArray::fromRawData(begin, static_cast<int>(end-begin)).trimmed().toDouble();
+    }
+
+    double value = exponent < 0 ? mantissa / powersOf10[-exponent] : mantissa * powersOf10[exponent];
+    return negative ? -value : value;
+}
+
+void StatisticsMatrix::parseRows(const char *begin, const char *end, Block &block)
+{
+    int nRows = block.versions.size();
+    int nColumns = block.header.size();
+    double *data = block.data.data();
+
+    int row = 0;
+    const char *p = begin;
+    while(p < end){
+        const char *eol = static_cast<const char *>(memchr(p, '\n', end-p));
+        if(eol == nullptr){
+            eol = end;
+        }
+        const char *lineEnd = eol;
+        if(lineEnd > p && lineEnd[-1] == '\r'){
+            --lineEnd;
+        }
+
+        if(lineEnd > p){
+            int field = 0;
+            const char *cell = p;
+            while(cell <= lineEnd){
+                const char *sep = static_cast<const char *>(memchr(cell, ',', lineEnd-cell));
+                if(sep == nullptr){
+                    sep = lineEnd;
+                }
+
+                if(field < nColumns){
+                    double value = parseDouble(cell, sep);
+                    if(field == 0){
+                        block.versions[row] = static_cast<int>(value);
+                    }
+                    data[static_cast<size_t>(field)*nRows + row] = value;
+                }
+
+                ++field;
+                cell = sep+1;
+            }
+            ++row;
+        }
+        p = eol+1;
+    }
+}
+
+void StatisticsMatrix::findLastLine(const char *begin, const char *end, qint64 offset, Block &block)
+{
+    const char *p = end;
+    while(p != begin && p[-1] != '\n'){
+        --p;
+    }
+    block.parsedBytes = offset + (p-begin);
+    block.partialRow = countRows(p, end) > 0;
+}
+
+QString StatisticsMatrix::cachePath(const QString &path)
+{
+    QString dir = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+    if(dir.isEmpty()){
+        return QString();
+    }
+    QByteArray key = QCryptographicHash::hash(QFileInfo(path).absoluteFilePath().toUtf8(), QCryptographicHash::Sha1).toHex();
+    return dir + "/statistics/" + QString::fromLatin1(key) + ".bin";
+}
+
+bool StatisticsMatrix::readCache(const QString &path, qint64 size, qint64 mtime, Block &block)
+{
+    QString cache = cachePath(path);
+    if(cache.isEmpty()){
+        return false;
+    }
+    QFile file(cache);
+    if(!file.open(QIODevice::ReadOnly) || file.size() < static_cast<qint64>(sizeof(CacheHeader))){
+        return false;
+    }
+    const uchar *begin = file.map(0, file.size());
+    if(begin == nullptr){
+        return false;
+    }
+
+    CacheHeader h;
+    memcpy(&h, begin, sizeof(CacheHeader));
+    if(memcmp(h.magic, cacheMagic, sizeof(cacheMagic)) != 0 || h.sourceSize != size || h.sourceMTime != mtime ||
+            h.nRows < 0 || h.nColumns < 0 || h.pathBytes < 0 || h.headerBytes < 0){
+        return false;
+    }
+
+    // the file content is not trusted, all sizes are validated in 64 bit against the file size before allocating
+    qint64 nValues = static_cast<qint64>(h.nRows)*h.nColumns;
+    if(nValues > maxValues){
+        return false;
+    }
+    qint64 pathOffset = align8(sizeof(CacheHeader));
+    qint64 headerOffset = align8(pathOffset + h.pathBytes);
+    qint64 versionsOffset = align8(headerOffset + h.headerBytes);
+    qint64 dataOffset = align8(versionsOffset + static_cast<qint64>(h.nRows)*static_cast<qint64>(sizeof(qint32)));
+    qint64 total = dataOffset + nValues*static_cast<qint64>(sizeof(double));
+    if(file.size() != total){
+        return false;
+    }
+
+    QString cachedPath = QString::fromUtf8(reinterpret_cast<const char *>(begin+pathOffset), h.pathBytes);
+    if(cachedPath != QFileInfo(path).absoluteFilePath()){
+        return false;
+    }
+
+    QString header = QString::fromUtf8(reinterpret_cast<const char *>(begin+headerOffset), h.headerBytes);
+    block.header = header.split(",",QString::SplitBehavior::SkipEmptyParts);
+    if(block.header.size() != h.nColumns){
+        block.header.clear();
+        return false;
+    }
+
+    block.versions.resize(h.nRows);
+    memcpy(block.versions.data(), begin+versionsOffset, static_cast<size_t>(h.nRows)*sizeof(qint32));
+    block.data.resize(static_cast<size_t>(nValues));
+    memcpy(block.data.data(), begin+dataOffset, static_cast<size_t>(nValues)*sizeof(double));
+    block.parsedBytes = h.parsedBytes;
+    block.partialRow = h.partialRow != 0;
+
+    return true;
+}
+
+void StatisticsMatrix::writeCache(const Block &block, qint64 size, qint64 mtime)
+{
+    QString cache = cachePath(block.path);
+    if(cache.isEmpty() || !QDir().mkpath(QFileInfo(cache).path())){
+        return;
+    }
+
+    QByteArray path = QFileInfo(block.path).absoluteFilePath().toUtf8();
+    QByteArray header = block.header.join(",").toUtf8();
+
+    CacheHeader h;
+    memcpy(h.magic, cacheMagic, sizeof(cacheMagic));
+    h.sourceSize = size;
+    h.sourceMTime = mtime;
+    h.parsedBytes = block.parsedBytes;
+    h.partialRow = block.partialRow ? 1 : 0;
+    h.nRows = block.versions.size();
+    h.nColumns = block.header.size();
+    h.pathBytes = path.size();
+    h.headerBytes = header.size();
+    h.reserved = 0;
+
+    QSaveFile file(cache);
+    if(!file.open(QIODevice::WriteOnly)){
+        return;
+    }
+
+    auto pad = [&file](){
+        static const char zeros[8] = {0};
+        file.write(zeros, align8(file.pos()) - file.pos());
+    };
+
+    file.write(reinterpret_cast<const char *>(&h), sizeof(CacheHeader));
+    pad();
+    file.write(path);
+    pad();
+    file.write(header);
+    pad();
+    file.write(reinterpret_cast<const char *>(block.versions.constData()), static_cast<qint64>(block.versions.size())*sizeof(qint32));
+    pad();
+    file.write(reinterpret_cast<const char *>(block.data.data()), static_cast<qint64>(block.data.size())*sizeof(double));
+    file.commit();
+}
+
+void StatisticsMatrix::pruneCache()
+{
+    QString dir = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+    if(dir.isEmpty()){
+        return;
+    }
+
+    // newest entries first, they are kept as long as the size limit allows it
+    QFileInfoList entries = QDir(dir + "/statistics").entryInfoList(QStringList() << "*.bin", QDir::Files, QDir::Time);
+    qint64 total = 0;
+    for(const auto &entry : entries){
+        QString source = cachedSourcePath(entry.absoluteFilePath());
+        if(!source.isEmpty() && QFileInfo::exists(source) && total + entry.size() <= maxCacheBytes){
+            total += entry.size();
+        }else{
+            QFile::remove(entry.absoluteFilePath());
+        }
+    }
+}
@@ -0,0 +1,213 @@
+/*
+ *  VieSched++ Very Long Baseline Interferometry (VLBI) Scheduling Software
+ *  Copyright (C) 2018  Matthias Schartner
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef STATISTICSMATRIX_H
+#define STATISTICSMATRIX_H
+
+#include <QFile>
+#include <QHash>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+#include <vector>
+
+/**
+ * @brief numeric content of one or more statistics.csv files
+ *
+ * Every header entry of the loaded files becomes one column, every version one row. Rows are sorted by session
+ * folder and version.
+ * Values are stored column-major in one contiguous buffer, so a full column (one statistic over all versions)
+ * can be read through a single pointer.
+ *
+ * Loading is done in two steps: each file is memory mapped and parsed into its own Block (thread-safe, can run
+ * concurrently for several files) and all blocks are merged afterwards.
+ *
+ * After parsing, a binary copy of each block is stored in the user cache directory. It is keyed by the path, size
+ * and modification time of the statistics file, so reopening an unchanged file only maps the cached copy.
+ */
+class StatisticsMatrix
+{
+public:
+
+    /**
+     * @brief parsed content of a single statistics.csv file
+     */
+    struct Block{
+        QString path;               ///< file path
+        QString folder;             ///< session folder
+        QString error;              ///< error message, empty if file was parsed successfully
+        QStringList header;         ///< column names of this file
+        QVector<int> versions;      ///< version number of each row
+        std::vector<double> data;   ///< column-major values (versions.size() values per column)
+        qint64 parsedBytes = 0;     ///< file offset behind the last complete line
+        bool partialRow = false;    ///< true if the last row was not terminated by a newline
+    };
+
+    StatisticsMatrix();
+
+    void clear();
+
+    /**
+     * @brief parse one statistics file
+     *
+     * Does not touch any shared state and can therefore be called from worker threads.
+     * A valid cached copy is used if available, otherwise the file is parsed and the cache is written.
+     *
+     * @param path path to statistics.csv file
+     * @return parsed file
+     */
+    static Block parseFile(const QString &path);
+
+    /**
+     * @brief remove outdated entries from the statistics cache
+     *
+     * Entries whose statistics file no longer exists are removed. If the cache exceeds its size limit, the least
+     * recently written entries are removed as well.
+     * Must not run concurrently with parseFile.
+     */
+    static void pruneCache();
+
+    /**
+     * @brief merge parsed files
+     *
+     * Columns with the same header name in different files are merged. Columns which are missing in one file are
+     * filled with zeros for the versions of this file.
+     * The rows are sorted by session folder and version.
+     *
+     * @param blocks parsed files
+     * @param errorPath path of the first file which could not be parsed (only set if false is returned)
+     * @param errorMessage reason why the file could not be parsed or merged (only set if false is returned)
+     * @return true if all blocks are valid
+     */
+    bool merge(const QVector<Block> &blocks, QString &errorPath, QString &errorMessage);
+
+    int rowCount() const{
+        return nRows_;
+    }
+
+    int columnCount() const{
+        return header_.size();
+    }
+
+    const QStringList &header() const{
+        return header_;
+    }
+
+    /**
+     * @brief column index of header entry
+     *
+     * @param name header name
+     * @return column index or -1 if there is no such column
+     */
+    int columnIndex(const QString &name) const{
+        return index_.value(name, -1);
+    }
+
+    const double *column(int col) const{
+        return data_.data() + static_cast<size_t>(col)*stride_;
+    }
+
+    double value(int row, int col) const{
+        return data_[static_cast<size_t>(col)*stride_ + row];
+    }
+
+    int version(int row) const{
+        return versions_.at(row);
+    }
+
+    const QString &folder(int row) const{
+        return files_.at(rowFile_.at(row)).folder;
+    }
+
+    int fileCount() const{
+        return files_.size();
+    }
+
+    const QString &path(int fileIdx) const{
+        return files_.at(fileIdx).path;
+    }
+
+    /**
+     * @brief remove columns in a single pass
+     *
+     * Kept columns are moved towards the front of the buffer, the header index is rebuilt once.
+     *
+     * @param keep flag per column, columns with false are removed
+     */
+    void removeColumns(const QVector<char> &keep);
+
+    /**
+     * @brief read data which was appended to a file since it was last read
+     *
+     * Only the new bytes are parsed. New versions are appended as rows, a previously incomplete last row is
+     * overwritten. Columns which are not part of the matrix (e.g. removed ones) are ignored.
+     * If the header of the file was not complete when it was loaded, it is read as soon as its newline arrived and
+     * its columns which are not part of the matrix yet are appended (zero for the rows of other files).
+     *
+     * @param fileIdx file index
+     * @return number of parsed rows (new or completed) or -1 if the file shrank, can not be read or grew too large (full
+     * reload necessary)
+     */
+    int readAppended(int fileIdx);
+
+private:
+    QStringList header_;            ///< column names
+    QHash<QString, int> index_;     ///< column index of each column name
+    /**
+     * @brief read state of a loaded file
+     */
+    struct File{
+        QString path;               ///< file path
+        QString folder;             ///< session folder
+        QStringList header;         ///< column names of this file
+        qint64 parsedBytes;         ///< file offset behind the last complete line
+        int partialRow;             ///< row index of incomplete last row or -1
+    };
+
+    QVector<File> files_;           ///< loaded files
+    QVector<int> rowFile_;          ///< file index of each row
+    QVector<int> versions_;         ///< version number of each row
+    std::vector<double> data_;      ///< column-major values (stride_ values per column)
+    int nRows_;
+    int stride_;                    ///< allocated rows per column (>= nRows_)
+
+    bool reserveRows(int n);
+
+    bool addColumns(const QStringList &names);
+
+    static bool allocate(int nRows, Block &block);
+
+    static QStringList splitHeader(const char *begin, const char *end);
+
+    static int countRows(const char *begin, const char *end);
+
+    static double parseDouble(const char *begin, const char *end);
+
+    static void parseRows(const char *begin, const char *end, Block &block);
+
+    static void findLastLine(const char *begin, const char *end, qint64 offset, Block &block);
+
+    static QString cachePath(const QString &path);
+
+    static bool readCache(const QString &path, qint64 size, qint64 mtime, Block &block);
+
+    static void writeCache(const Block &block, qint64 size, qint64 mtime);
+};
+
+#endif // STATISTICSMATRIX_H
@@ -0,0 +1,197 @@
+/*
+ *  VieSched++ Very Long Baseline Interferometry (VLBI) Scheduling Software
+ *  Copyright (C) 2018  Matthias Schartner
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "statisticsscore.h"
+
+#include <algorithm>
+#include <numeric>
+#include <cmath>
+
+void StatisticsScore::columnTransformation(const StatisticsMatrix &matrix, int col, bool removeMinimum, bool relative,
+                                           double &offset, double &scale)
+{
+    offset = 0;
+    scale = 1;
+
+    int n = matrix.rowCount();
+    if(n == 0 || (!removeMinimum && !relative)){
+        return;
+    }
+
+    const double *v = matrix.column(col);
+    double lo = v[0];
+    double hi = v[0];
+    #pragma omp simd reduction(min:lo) reduction(max:hi)
+    for(int i=1; i<n; ++i){
+        lo = std::min(lo, v[i]);
+        hi = std::max(hi, v[i]);
+    }
+
+    if(removeMinimum){
+        offset = lo;
+        hi -= lo;
+    }
+    if(relative){
+        scale = hi != 0 ? 1/hi : 0;
+    }
+}
+
+QVector<double> StatisticsScore::weightedScore(const StatisticsMatrix &matrix, const QVector<QPair<int, double>> &weights,
+                                               bool removeMinimum, bool relative)
+{
+    int n = matrix.rowCount();
+    QVector<double> score(n, 0.0);
+    double *s = score.data();
+
+    // sum_c w_c * (v_c - offset_c) * scale_c = sum_c (w_c * scale_c) * v_c - sum_c w_c * scale_c * offset_c
+    double constant = 0;
+    for(const auto &any : weights){
+        if(any.first < 0 || any.first >= matrix.columnCount() || any.second == 0){
+            continue;
+        }
+
+        double offset;
+        double scale;
+        columnTransformation(matrix, any.first, removeMinimum, relative, offset, scale);
+        double factor = any.second * scale;
+        if(factor == 0){
+            continue;
+        }
+        constant -= factor * offset;
+
+        const double *v = matrix.column(any.first);
+        #pragma omp simd
+        for(int i=0; i<n; ++i){
+            s[i] += factor * v[i];
+        }
+    }
+
+    if(constant != 0){
+        #pragma omp simd
+        for(int i=0; i<n; ++i){
+            s[i] += constant;
+        }
+    }
+
+    return score;
+}
+
+QVector<int> StatisticsScore::topK(const QVector<double> &score, int k)
+{
+    int n = score.size();
+    k = std::max(0, std::min(k, n));
+
+    QVector<int> idx(n);
+    std::iota(idx.begin(), idx.end(), 0);
+    auto cmp = [&score](int i1, int i2){
+        return score[i1] > score[i2] || (score[i1] == score[i2] && i1 < i2);
+    };
+    if(k < n){
+        std::nth_element(idx.begin(), idx.begin()+k, idx.end(), cmp);
+    }
+    std::sort(idx.begin(), idx.begin()+k, cmp);
+    idx.resize(k);
+
+    return idx;
+}
+
+QVector<int> StatisticsScore::paretoFront(const StatisticsMatrix &matrix, const QVector<QPair<int, bool>> &criteria)
+{
+    int n = matrix.rowCount();
+    int d = 0;
+    QVector<const double *> columns;
+    QVector<double> signs;
+    for(const auto &any : criteria){
+        if(any.first >= 0 && any.first < matrix.columnCount()){
+            columns.append(matrix.column(any.first));
+            signs.append(any.second ? 1 : -1);
+            ++d;
+        }
+    }
+    if(d == 0 || n == 0){
+        return QVector<int>();
+    }
+
+    // row-major copy with all criteria oriented so that larger is better (cache friendly dominance checks)
+    std::vector<double> values(static_cast<size_t>(n)*d);
+    std::vector<double> sum(n, 0.0);
+    std::vector<char> valid(n, 1);
+    for(int c=0; c<d; ++c){
+        const double *v = columns.at(c);
+        double sign = signs.at(c);
+        for(int r=0; r<n; ++r){
+            double x = sign * v[r];
+            values[static_cast<size_t>(r)*d + c] = x;
+            sum[r] += x;
+            if(std::isnan(x)){
+                valid[r] = 0;
+            }
+        }
+    }
+
+    QVector<int> order;
+    order.reserve(n);
+    for(int r=0; r<n; ++r){
+        if(valid[r]){
+            order.append(r);
+        }
+    }
+    // lexicographic tie break keeps the order correct if rounding makes the sums of dominating rows equal
+    std::sort(order.begin(), order.end(), [&](int i1, int i2){
+        if(sum[i1] != sum[i2]){
+            return sum[i1] > sum[i2];
+        }
+        const double *a = values.data() + static_cast<size_t>(i1)*d;
+        const double *b = values.data() + static_cast<size_t>(i2)*d;
+        for(int c=0; c<d; ++c){
+            if(a[c] != b[c]){
+                return a[c] > b[c];
+            }
+        }
+        return i1 < i2;
+    });
+
+    QVector<int> front;
+    for(int r : order){
+        const double *b = values.data() + static_cast<size_t>(r)*d;
+        bool dominated = false;
+        for(int f : front){
+            const double *a = values.data() + static_cast<size_t>(f)*d;
+            bool betterOrEqual = true;
+            bool better = false;
+            for(int c=0; c<d; ++c){
+                if(a[c] < b[c]){
+                    betterOrEqual = false;
+                    break;
+                }
+                if(a[c] > b[c]){
+                    better = true;
+                }
+            }
+            if(betterOrEqual && better){
+                dominated = true;
+                break;
+            }
+        }
+        if(!dominated){
+            front.append(r);
+        }
+    }
+
+    return front;
+}
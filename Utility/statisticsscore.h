@@ -0,0 +1,89 @@
+/*
+ *  VieSched++ Very Long Baseline Interferometry (VLBI) Scheduling Software
+ *  Copyright (C) 2018  Matthias Schartner
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef STATISTICSSCORE_H
+#define STATISTICSSCORE_H
+
+#include <QPair>
+#include <QVector>
+
+#include "statisticsmatrix.h"
+
+/**
+ * @brief weighted score of multi scheduling versions
+ *
+ * Each statistic is transformed to (value - offset) * scale, where the offset is the column minimum if the minimum
+ * should be removed and the scale is 1/maximum (after removing the minimum) for relative values.
+ * The score of a version is the weighted sum of the transformed statistics.
+ */
+namespace StatisticsScore {
+
+    /**
+     * @brief offset and scale of one statistic
+     *
+     * If relative values are requested but the maximum is zero, the scale is set to zero.
+     *
+     * @param matrix statistics
+     * @param col column index
+     * @param removeMinimum subtract column minimum
+     * @param relative divide by column maximum
+     * @param offset value which is subtracted
+     * @param scale factor which is applied after subtracting the offset
+     */
+    void columnTransformation(const StatisticsMatrix &matrix, int col, bool removeMinimum, bool relative,
+                              double &offset, double &scale);
+
+    /**
+     * @brief weighted score of all versions
+     *
+     * @param matrix statistics
+     * @param weights list of column index and weight
+     * @param removeMinimum subtract column minimum
+     * @param relative divide by column maximum
+     * @return score per row of the matrix
+     */
+    QVector<double> weightedScore(const StatisticsMatrix &matrix, const QVector<QPair<int, double>> &weights,
+                                  bool removeMinimum, bool relative);
+
+    /**
+     * @brief indices of the k versions with the highest score
+     *
+     * Uses partial selection (nth_element) and only sorts the selected k versions.
+     * Equal scores are ordered by row index.
+     *
+     * @param score score per row
+     * @param k number of versions
+     * @return row indices sorted by descending score
+     */
+    QVector<int> topK(const QVector<double> &score, int k);
+
+    /**
+     * @brief non-dominated versions (Pareto front)
+     *
+     * Sort-filter-skyline: rows are sorted by a monotone function of all criteria, so no row can be dominated by a
+     * row which comes later. Each row therefore only has to be compared against the current front, which is
+     * O(n log n + n * front size) and scales to large numbers of versions.
+     *
+     * @param matrix statistics
+     * @param criteria list of column index and flag if larger values are better
+     * @return row indices of non-dominated versions
+     */
+    QVector<int> paretoFront(const StatisticsMatrix &matrix, const QVector<QPair<int, bool>> &criteria);
+}
+
+#endif // STATISTICSSCORE_H
@@ -0,0 +1,95 @@
+/*
+ *  VieSched++ Very Long Baseline Interferometry (VLBI) Scheduling Software
+ *  Copyright (C) 2018  Matthias Schartner
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "uvcoveragecache.h"
+
+#include <algorithm>
+
+UVCoverageCache::UVCoverageCache()
+{
+}
+
+void UVCoverageCache::compute(const VieVS::Scheduler &schedule, double sessionStartMjd)
+{
+    const VieVS::Network &network = schedule.getNetwork();
+    const std::vector<VieVS::Source> &sources = schedule.getSources();
+    const std::vector<VieVS::Scan> &scans = schedule.getScans();
+    int nsrc = sources.size();
+    int nsta = network.getNSta();
+
+    // scans per source and baseline names (serial, cheap)
+    QVector<QVector<int>> scansPerSource(nsrc);
+    baselineNames_ = QVector<QString>(network.getNBls());
+    for(int i=0; i<static_cast<int>(scans.size()); ++i){
+        const VieVS::Scan &scan = scans[i];
+        scansPerSource[scan.getSourceId()].append(i);
+        for(const VieVS::Observation &obs: scan.getObservations()){
+            QString &bl = baselineNames_[obs.getBlid()];
+            if(bl.isEmpty()){
+                bl = QString::fromStdString(network.getStation(obs.getStaid1()).getAlternativeName()+"-"+
+                                            network.getStation(obs.getStaid2()).getAlternativeName());
+            }
+        }
+    }
+
+    points_ = QVector<QVector<Point>>(nsrc);
+    QVector<Point> *out = points_.data();
+
+    #pragma omp parallel
+    {
+        // index of station id inside current scan
+        std::vector<int> staidx(nsta, -1);
+
+        #pragma omp for schedule(dynamic)
+        for(int srcid=0; srcid<nsrc; ++srcid){
+            const VieVS::Source &source = sources[srcid];
+            QVector<Point> &points = out[srcid];
+
+            for(int iscan : scansPerSource.at(srcid)){
+                const VieVS::Scan &scan = scans[iscan];
+                for(int i=0; i<scan.getNSta(); ++i){
+                    staidx[scan.getStationId(i)] = i;
+                }
+
+                for(const VieVS::Observation &obs: scan.getObservations()){
+                    unsigned long staid1 = obs.getStaid1();
+                    unsigned long staid2 = obs.getStaid2();
+                    int idx1 = staidx[staid1];
+                    int idx2 = staidx[staid2];
+                    const std::vector<double> &dxyz = network.getDxyz(staid1,staid2);
+
+                    double mjd = sessionStartMjd + obs.getStartTime()/86400.0;
+                    double gmst  = iauGmst82(2400000.5,mjd);
+                    std::pair<double, double> uv = source.calcUV(gmst, dxyz);
+
+                    Point p;
+                    p.u = uv.first;
+                    p.v = uv.second;
+                    p.startTime = std::max({scan.getTimes().getObservingTime(idx1,VieVS::Timestamp::start), scan.getTimes().getObservingTime(idx2,VieVS::Timestamp::start)});
+                    p.endTime   = std::min({scan.getTimes().getObservingTime(idx1,VieVS::Timestamp::end),   scan.getTimes().getObservingTime(idx2,VieVS::Timestamp::end)});
+                    p.blid = obs.getBlid();
+                    points.append(p);
+                }
+
+                for(int i=0; i<scan.getNSta(); ++i){
+                    staidx[scan.getStationId(i)] = -1;
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,90 @@
+/*
+ *  VieSched++ Very Long Baseline Interferometry (VLBI) Scheduling Software
+ *  Copyright (C) 2018  Matthias Schartner
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UVCOVERAGECACHE_H
+#define UVCOVERAGECACHE_H
+
+#include <QString>
+#include <QVector>
+
+#include "../VieSchedpp/Scheduler.h"
+
+/**
+ * @brief uv coordinates of all observations, grouped per source
+ *
+ * u and v are stored in meters. The conversion to wavelengths of a band is a single multiplication which is done
+ * when the points are plotted.
+ *
+ * The points of different sources are computed in parallel (OpenMP). compute() is usually called from a worker thread,
+ * the cache must not be accessed before it returns.
+ */
+class UVCoverageCache
+{
+public:
+
+    /**
+     * @brief uv coordinate of one observation
+     */
+    struct Point{
+        double u;                   ///< u coordinate [m]
+        double v;                   ///< v coordinate [m]
+        int startTime;              ///< common observing start of both stations
+        int endTime;                ///< common observing end of both stations
+        int blid;                   ///< baseline id
+    };
+
+    UVCoverageCache();
+
+    /**
+     * @brief compute uv coordinates of all observations
+     *
+     * @param schedule schedule
+     * @param sessionStartMjd modified julian date of session start
+     */
+    void compute(const VieVS::Scheduler &schedule, double sessionStartMjd);
+
+    /**
+     * @brief uv coordinates of one source
+     *
+     * @param srcid source id
+     * @return uv coordinates in the order of the scans
+     */
+    const QVector<Point> &points(int srcid) const{
+        return points_.at(srcid);
+    }
+
+    /**
+     * @brief baseline name in the form "id1-id2"
+     *
+     * @param blid baseline id
+     * @return baseline name
+     */
+    const QString &baselineName(int blid) const{
+        return baselineNames_.at(blid);
+    }
+
+    const QVector<QString> &baselineNames() const{
+        return baselineNames_;
+    }
+
+private:
+    QVector<QVector<Point>> points_;    ///< uv coordinates per source
+    QVector<QString> baselineNames_;    ///< baseline name per baseline id
+};
+
+#endif // UVCOVERAGECACHE_H
@@ -28,7 +28,7 @@ CONFIG(debug, debug|release):message(Debug build)
 QMAKE_CXXFLAGS+= -fopenmp
 LIBS += -fopenmp
 
-QT += core gui charts
+QT += core gui charts concurrent
 DEFINES += VieSchedppOnline=false
 
 # Comment the following lines for offline installation only without QT NETWORK
@@ -179,12 +179,25 @@ SOURCES += \
     secondaryGUIs/skedcataloginfo.cpp \
     secondaryGUIs/textfileviewer.cpp \
     secondaryGUIs/vieschedpp_analyser.cpp \
+    Utility/animatedpngwriter.cpp \
     Utility/callout.cpp \
+    Utility/elevationtrackcache.cpp \
     Utility/chartview.cpp \
+    Utility/histogram.cpp \
+    Utility/intervalwindow.cpp \
     Utility/multicolumnsortfilterproxymodel.cpp \
+    Utility/offscreenplot.cpp \
+    Utility/pointindex.cpp \
+    Utility/polarheatmap.cpp \
     Utility/mytextbrowser.cpp \
     Utility/qtutil.cpp \
+    Utility/scanintervalindex.cpp \
+    Utility/skycoverageraster.cpp \
     Utility/statistics.cpp \
+    Utility/statisticsmatrix.cpp \
+    Utility/statisticsscore.cpp \
+    Utility/stationtimebudget.cpp \
+    Utility/uvcoveragecache.cpp \
     secondaryGUIs/rendersetup.cpp \
     mainwindows_save_and_load.cpp
 
@@ -288,13 +301,26 @@ HEADERS += \
     secondaryGUIs/skedcataloginfo.h \
     secondaryGUIs/textfileviewer.h \
     secondaryGUIs/vieschedpp_analyser.h \
+    Utility/animatedpngwriter.h \
     Utility/callout.h \
+    Utility/elevationtrackcache.h \
     Utility/chartview.h \
+    Utility/histogram.h \
+    Utility/intervalwindow.h \
     Utility/multicolumnsortfilterproxymodel.h \
+    Utility/offscreenplot.h \
+    Utility/pointindex.h \
+    Utility/polarheatmap.h \
     Utility/mytextbrowser.h \
     Utility/qtutil.h \
+    Utility/scanintervalindex.h \
+    Utility/skycoverageraster.h \
     mainwindow.h \
     Utility/statistics.h \
+    Utility/statisticsmatrix.h \
+    Utility/statisticsscore.h \
+    Utility/stationtimebudget.h \
+    Utility/uvcoveragecache.h \
     secondaryGUIs/rendersetup.h
 
 FORMS += \
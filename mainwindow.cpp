@@ -436,6 +436,7 @@ MainWindow::MainWindow(QWidget *parent) :
                                 ui->spinBox_statistics_show,
                                 ui->listWidget_statistics,
                                 ui->checkBox_statistics_removeMinimum,
+                                ui->checkBox_statistics_follow,
                                 ui->radioButton_statistics_relative,
                                 ui->radioButton_statistics_absolute,
                                 ui->lineEdit_outputPath);
@@ -5551,22 +5552,12 @@ void MainWindow::on_treeView_allSelectedSources_clicked(const QModelIndex &index
 
     clearGroup(false,true,false,name);
 
-    int row;
-    double x;
-    double y;
+    double x = 0;
+    double y = 0;
     for(int i = 0; i < allSourceModel->rowCount(); ++i){
         if (allSourceModel->index(i,0).data().toString() == name){
-            row = i;
-            double ra = allSourceModel->index(i,1).data().toDouble();
-            double dc = allSourceModel->index(i,2).data().toDouble();
-            ra -=180;
-
-            double lambda = qDegreesToRadians(ra);
-            double phi = qDegreesToRadians(dc);
-            double hn = qSqrt( 1 + qCos(phi)*qCos(lambda/2) );
-
-            x = (2 * qSqrt(2) *qCos(phi) *qSin(lambda/2) ) / hn;
-            y = (qSqrt(2) *qSin(phi) ) / hn;
+            x = skymapIndex.point(i).x();
+            y = skymapIndex.point(i).y();
             break;
         }
     }
@@ -5608,17 +5599,7 @@ void MainWindow::on_treeView_allAvailabeSources_clicked(const QModelIndex &index
 
         selectedSourceModel->sort(0);
 
-        double ra = allSourceProxyModel->index(row,1).data().toDouble();
-        double dc = allSourceProxyModel->index(row,2).data().toDouble();
-        ra -=180;
-
-        double lambda = qDegreesToRadians(ra);
-        double phi = qDegreesToRadians(dc);
-        double hn = qSqrt( 1 + qCos(phi)*qCos(lambda/2) );
-
-        double x = (2 * qSqrt(2) *qCos(phi) *qSin(lambda/2) ) / hn;
-        double y = (qSqrt(2) *qSin(phi) ) / hn;
-        selectedSources->append(x,y);
+        selectedSources->append(skymapIndex.point(nrow));
 
         int r = 0;
         for(int i = 0; i<allSourcePlusGroupModel->rowCount(); ++i){
@@ -5722,6 +5703,8 @@ void MainWindow::plotSkyMap(){
     connect(availableSources,SIGNAL(hovered(QPointF,bool)),this,SLOT(skymap_hovered(QPointF,bool)));
     connect(selectedSources,SIGNAL(hovered(QPointF,bool)),this,SLOT(skymap_hovered(QPointF,bool)));
 
+    // projected positions are indexed once, hover lookups and marker placement use the index
+    QVector<QPointF> positions(allSourceModel->rowCount());
     for(int i = 0; i< allSourceModel->rowCount(); ++i){
         double ra = allSourceModel->item(i,1)->text().toDouble();
         double lambda = qDegreesToRadians(ra);
@@ -5730,10 +5713,12 @@ void MainWindow::plotSkyMap(){
         double phi = qDegreesToRadians(dc);
 
         auto xy = qtUtil::radec2xy(lambda, phi);
-
-        availableSources->append(xy.first, xy.second);
-        selectedSources->append(xy.first, xy.second);
+        positions[i] = QPointF(xy.first, xy.second);
     }
+    skymapIndex.build(positions);
+
+    availableSources->replace(skymapIndex.points());
+    selectedSources->replace(skymapIndex.points());
 
     availableSources->attachAxis(skyChart->axisX());
     availableSources->attachAxis(skyChart->axisY());
@@ -5755,19 +5740,14 @@ void MainWindow::skymap_hovered(QPointF point, bool state){
         pra +=180;
         double pde = qRadiansToDegrees(qAsin(z*py));
 
+        // all sources within a radius in projected (Hammer) map units, about 3 deg near the map centre and
+        // stretched towards the edges of the map
         QString src;
-        for(int i = 0; i<allSourceModel->rowCount();++i){
-            double ra = allSourceModel->index(i,1).data().toDouble();
-            double de = allSourceModel->index(i,2).data().toDouble();
-
-            auto dra = ra-pra;
-            auto dde = de-pde;
-            if(dra*dra+dde*dde < 10){
-                if(src.size()==0){
-                    src.append(allSourceModel->index(i,0).data().toString());
-                }else{
-                    src.append(","+allSourceModel->index(i,0).data().toString());
-                }
+        for(int i : skymapIndex.within(point, qDegreesToRadians(qSqrt(10.)))){
+            if(src.size()==0){
+                src.append(allSourceModel->index(i,0).data().toString());
+            }else{
+                src.append(","+allSourceModel->index(i,0).data().toString());
             }
         }
 
@@ -6695,24 +6675,25 @@ void MainWindow::on_pushButton_parse_clicked()
             try{
                 VieVS::SkdParser mySkdParser(path.toStdString());
                 mySkdParser.read();
-                parsedSchedule = mySkdParser.createScheduler();
+                std::shared_ptr<VieVS::Scheduler> schedule = std::make_shared<VieVS::Scheduler>(mySkdParser.createScheduler());
+                parsedSchedule = schedule;
                 parsedFreq = mySkdParser.getFrequencies();
                 std::string start = VieVS::TimeSystem::time2string(VieVS::TimeSystem::startTime);
                 std::string end = VieVS::TimeSystem::time2string(VieVS::TimeSystem::endTime);
                 QDateTime qstart = QDateTime::fromString(QString::fromStdString(start),"yyyy.MM.dd HH:mm:ss");
                 QDateTime qend   = QDateTime::fromString(QString::fromStdString(end),"yyyy.MM.dd HH:mm:ss");
 
-                ui->lineEdit_parseExpName->setText(QString::fromStdString(parsedSchedule->getName()));
+                ui->lineEdit_parseExpName->setText(QString::fromStdString(schedule->getName()));
                 ui->dateTimeEdit_parseSessionStart->setDateTime(qstart);
                 ui->dateTimeEdit_parseSessionEnd->setDateTime(qend);
-                ui->spinBox_parseStations->setValue(parsedSchedule->getNetwork().getStations().size());
-                ui->spinBox_parseSources->setValue(parsedSchedule->getSources().size());
-                ui->spinBox_parseScans->setValue(parsedSchedule->getScans().size());
-                ui->spinBox_parseObs->setValue(parsedSchedule->getNumberOfObservations());
+                ui->spinBox_parseStations->setValue(schedule->getNetwork().getStations().size());
+                ui->spinBox_parseSources->setValue(schedule->getSources().size());
+                ui->spinBox_parseScans->setValue(schedule->getScans().size());
+                ui->spinBox_parseObs->setValue(schedule->getNumberOfObservations());
 
                 const QFont fixedFont = QFontDatabase::systemFont(QFontDatabase::FixedFont);
-                const auto &sources = parsedSchedule->getSources();
-                const auto &network = parsedSchedule->getNetwork();
+                const auto &sources = schedule->getSources();
+                const auto &network = schedule->getNetwork();
                 QString txt = " Source      Start      DURATIONS           \n";
                 txt .append(" name     yyddd-hhmmss   ") ;
                 for (const auto &any : network.getStations()){
@@ -6720,13 +6701,13 @@ void MainWindow::on_pushButton_parse_clicked()
                 }
                 txt.append("\n");
 
-                for(const auto &any : parsedSchedule->getScans()){
+                for(const auto &any : schedule->getScans()){
                     txt.append(QString::fromStdString(any.toSkedOutputTimes(sources[any.getSourceId()], network.getNSta())));
                 }
                 ui->plainTextEdit_parseOutput->setFont(fixedFont);
                 ui->plainTextEdit_parseOutput->setPlainText(txt);
 
-                const auto &obsMode = parsedSchedule->getObservingMode();
+                const auto &obsMode = schedule->getObservingMode();
                 const auto &mode = obsMode->getMode(0);
                 const auto &bands = mode->getAllBands();
                 double recRate = 0;
@@ -6756,11 +6737,11 @@ void MainWindow::on_pushButton_parse_clicked()
 void MainWindow::on_pushButton_sessionAnalyser_clicked()
 {
     try {
-        if(parsedSchedule.is_initialized()){
+        if(parsedSchedule){
 
             QDateTime qstart = ui->dateTimeEdit_parseSessionStart->dateTime();
             QDateTime qend   = ui->dateTimeEdit_parseSessionEnd->dateTime();
-            VieSchedpp_Analyser *analyser = new VieSchedpp_Analyser(*parsedSchedule,parsedFreq,qstart,qend, this);
+            VieSchedpp_Analyser *analyser = new VieSchedpp_Analyser(parsedSchedule,parsedFreq,qstart,qend, this);
             analyser->show();
         }
     } catch (...){
@@ -6775,7 +6756,7 @@ void MainWindow::on_pushButton_sessionAnalyser_clicked()
 
 void MainWindow::on_pushButton_outputNgsFild_clicked()
 {
-    if(parsedSchedule.is_initialized()){
+    if(parsedSchedule){
         QString startPath = ui->lineEdit_sessionPath->text();
         QString path = QFileDialog::getExistingDirectory(this, "Browse to folder", startPath);
         if( !path.isEmpty() ){
@@ -6809,7 +6790,7 @@ void MainWindow::on_pushButton_outputNgsFild_clicked()
 
 void MainWindow::on_pushButton_outputSnrTable_2_clicked()
 {
-    if(parsedSchedule.is_initialized()){
+    if(parsedSchedule){
         QString startPath = ui->lineEdit_sessionPath->text();
         QString path = QFileDialog::getExistingDirectory(this, "Browse to folder", startPath);
         if( !path.isEmpty() ){
@@ -6844,7 +6825,7 @@ void MainWindow::on_pushButton_outputSnrTable_2_clicked()
 
 void MainWindow::on_pushButton_outputSnrTable_clicked()
 {
-    if(parsedSchedule.is_initialized()){
+    if(parsedSchedule){
         QString startPath = ui->lineEdit_sessionPath->text();
         QString path = QFileDialog::getExistingDirectory(this, "Browse to folder", startPath);
         if( !path.isEmpty() ){
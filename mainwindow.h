@@ -72,6 +72,7 @@
 #include "Utility/qtutil.h"
 #include "secondaryGUIs/skedcataloginfo.h"
 #include "Utility/multicolumnsortfilterproxymodel.h"
+#include "Utility/pointindex.h"
 #include "secondaryGUIs/obsmodedialog.h"
 #include "Utility/statistics.h"
 #include "secondaryGUIs/mastersessionviewer.h"
@@ -621,6 +622,7 @@ private:
     QScatterSeries *selectedStations;
     QScatterSeries *availableSources;
     QScatterSeries *selectedSources;
+    PointIndex skymapIndex;
 
     Callout *worldMapCallout;
     Callout *skyMapCallout;
@@ -651,7 +653,7 @@ private:
     std::map<std::string, VieVS::ParameterSettings::ParametersBaselines> paraBl;
 
     Statistics *statistics;
-    boost::optional<VieVS::Scheduler> parsedSchedule;
+    std::shared_ptr<const VieVS::Scheduler> parsedSchedule;
     std::map<std::string, std::vector<double>> parsedFreq;
 
     void readSkedCatalogs();
@@ -11,6 +11,8 @@ RenderSetup::RenderSetup(QWidget *parent) :
     connect(ui->spinBox_increment, SIGNAL(valueChanged(int)), this, SLOT(updatePlotCounter()));
     connect(ui->spinBox_width, SIGNAL(valueChanged(int)), ui->spinBox_height, SLOT(setValue(int)));
     connect(ui->spinBox_height, SIGNAL(valueChanged(int)), ui->spinBox_width, SLOT(setValue(int)));
+
+    enableAnimation(false);
 }
 
 RenderSetup::~RenderSetup()
@@ -79,6 +81,25 @@ void RenderSetup::setDefaultFormat(int w, int h)
     ui->checkBox_fixRatio->setCheckState(status);
 }
 
+void RenderSetup::enableAnimation(bool flag)
+{
+    ui->checkBox_animation->setVisible(flag);
+    ui->spinBox_frameDelay->setVisible(flag);
+    if(!flag){
+        ui->checkBox_animation->setChecked(false);
+    }
+}
+
+bool RenderSetup::animation()
+{
+    return ui->groupBox_timeSeries->isChecked() && ui->checkBox_animation->isChecked();
+}
+
+int RenderSetup::frameDelay()
+{
+    return ui->spinBox_frameDelay->value();
+}
+
 void RenderSetup::on_checkBox_fixRatio_toggled(bool checked)
 {
     if(checked){
@@ -33,6 +33,12 @@ public:
 
     void setDefaultFormat(int w, int h);
 
+    void enableAnimation(bool flag);
+
+    bool animation();
+
+    int frameDelay();
+
 private slots:
 
     void on_checkBox_fixRatio_toggled(bool checked);
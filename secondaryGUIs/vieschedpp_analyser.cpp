@@ -19,8 +19,8 @@
 #include "secondaryGUIs/vieschedpp_analyser.h"
 #include "ui_vieschedpp_analyser.h"
 
-VieSchedpp_Analyser::VieSchedpp_Analyser(VieVS::Scheduler schedule, std::map<std::string, std::vector<double>> freqs, QDateTime start, QDateTime end, QWidget *parent) :
-    QMainWindow(parent), schedule_{schedule}, sessionStart_{start}, sessionEnd_{end},
+VieSchedpp_Analyser::VieSchedpp_Analyser(std::shared_ptr<const VieVS::Scheduler> schedule, std::map<std::string, std::vector<double>> freqs, QDateTime start, QDateTime end, QWidget *parent) :
+    QMainWindow(parent), scheduleHandle_{schedule}, schedule_{*schedule}, sessionStart_{start}, sessionEnd_{end},
     ui(new Ui::VieSchedpp_Analyser)
 {
     ui->setupUi(this);
@@ -46,13 +46,42 @@ VieSchedpp_Analyser::VieSchedpp_Analyser(VieVS::Scheduler schedule, std::map<std
     srcModel = new QStandardItemModel(0,6,this);
     staModel = new QStandardItemModel(0,6,this);
     blModel = new QStandardItemModel(0,4,this);
+
+    uvCacheFuture_ = QtConcurrent::run([this](){
+        uvCache_.compute(schedule_, sessionStartMjd_);
+    });
+    int sessionDuration = sessionStart_.secsTo(sessionEnd_);
+    elevationCacheFuture_ = QtConcurrent::run([this, sessionDuration](){
+        elevationCache_.compute(schedule_, sessionDuration);
+    });
+
+    windowRevision_ = 0;
+    windowApplied_ = false;
+    appliedStart_ = 0;
+    appliedEnd_ = 0;
+    windowTimer_ = new QTimer(this);
+    windowTimer_->setSingleShot(true);
+    windowTimer_->setInterval(50);
+    connect(windowTimer_, SIGNAL(timeout()), this, SLOT(startWindowUpdate()));
+    windowWatcher_ = new QFutureWatcher<void>(this);
+    connect(windowWatcher_, SIGNAL(finished()), this, SLOT(windowUpdateFinished()));
+
+    // projected marker positions, the id of a point is the station or source id
+    QVector<QPointF> positions;
+    for(const VieVS::Station &station : schedule_.getNetwork().getStations()){
+        positions.append(QPointF(station.getPosition().getLon()*rad2deg, station.getPosition().getLat()*rad2deg));
+    }
+    stationIndex_.build(positions);
+    positions.clear();
+    for(const VieVS::Source &source : schedule_.getSources()){
+        auto xy = qtUtil::radec2xy(source.getRa(), source.getDe());
+        positions.append(QPointF(xy.first, xy.second));
+    }
+    sourceIndex_.build(positions);
+
     setup();
-    setupWorldmap();
-    setupSkymap();
-    statisticsGeneralSetup();
-    statisticsStationsSetup();
-    statisticsSourceSetup();
-    statisticsBaselineSetup();
+    scanIndex_.build(schedule_);
+    timeBudget_.build(schedule_);
 
     ui->dateTimeEdit_start->setDateTimeRange(sessionStart_,sessionEnd_);
     ui->dateTimeEdit_end->setDateTimeRange(sessionStart_,sessionEnd_);
@@ -85,59 +114,79 @@ VieSchedpp_Analyser::VieSchedpp_Analyser(VieVS::Scheduler schedule, std::map<std
     QHeaderView *hv = ui->tableWidget_general->verticalHeader();
     hv->setSectionResizeMode(QHeaderView::ResizeToContents);
 
+    // charts of the other tabs are created when the tab is shown for the first time
+    tabInitialized_ = QVector<bool>(ui->stackedWidget->count(), false);
+    showTab(0);
+
 }
 
 VieSchedpp_Analyser::~VieSchedpp_Analyser()
 {
+    windowCancel_.fetchAndStoreRelaxed(1);
+    windowWatcher_->waitForFinished();
+    uvCacheFuture_.waitForFinished();
+    elevationCacheFuture_.waitForFinished();
     delete ui;
 }
 
+const UVCoverageCache &VieSchedpp_Analyser::uvCache()
+{
+    uvCacheFuture_.waitForFinished();
+    return uvCache_;
+}
+
+const ElevationTrackCache &VieSchedpp_Analyser::elevationCache()
+{
+    elevationCacheFuture_.waitForFinished();
+    return elevationCache_;
+}
+
 void VieSchedpp_Analyser::on_actionsky_coverage_triggered()
 {
-    ui->stackedWidget->setCurrentIndex(0);
+    showTab(0);
     updateSkyCoverageTimes();
 }
 
 void VieSchedpp_Analyser::on_actionworld_map_triggered()
 {
-    ui->stackedWidget->setCurrentIndex(1);
+    showTab(1);
     updateWorldmapTimes();
 }
 
 void VieSchedpp_Analyser::on_actionuv_coverage_triggered()
 {
-    ui->stackedWidget->setCurrentIndex(2);
+    showTab(2);
     updateUVTimes();
 }
 
 void VieSchedpp_Analyser::on_actionsky_map_triggered()
 {
-    ui->stackedWidget->setCurrentIndex(3);
+    showTab(3);
     updateSkymapTimes();
 }
 
 
 void VieSchedpp_Analyser::on_actiongeneral_triggered()
 {
-    ui->stackedWidget->setCurrentIndex(4);
+    showTab(4);
     updateGeneralStatistics();
 }
 
 void VieSchedpp_Analyser::on_actionper_station_triggered()
 {
-    ui->stackedWidget->setCurrentIndex(5);
+    showTab(5);
     updateStatisticsStations();
 }
 
 void VieSchedpp_Analyser::on_actionper_source_triggered()
 {
-    ui->stackedWidget->setCurrentIndex(6);
+    showTab(6);
     updateStatisticsSource();
 }
 
 void VieSchedpp_Analyser::on_actionper_baseline_triggered()
 {
-    ui->stackedWidget->setCurrentIndex(7);
+    showTab(7);
     updateStatisticsBaseline();
 }
 
@@ -227,8 +276,10 @@ void VieSchedpp_Analyser::setup()
     blModel->setHeaderData(2, Qt::Horizontal, QObject::tr("#obs"));
     blModel->setHeaderData(3, Qt::Horizontal, QObject::tr("distance [km]"));
     blModel->setRowCount(schedule_.getNetwork().getBaselines().size());
+    baselineRow_ = QVector<int>(schedule_.getNetwork().getBaselines().size(), -1);
     i=0;
     for(const VieVS::Baseline &any : schedule_.getNetwork().getBaselines()){
+        baselineRow_[any.getId()] = i;
         QString name = QString::fromStdString(any.getName());
         std::string id1 = name.left(2).toStdString();
         std::string id2 = name.right(2).toStdString();
@@ -274,9 +325,33 @@ void VieSchedpp_Analyser::setup()
     }
     blsWorldmap->sort(0);
 
+//    ui->splitter_skyCoverage->setSizes(QList<int>({std::numeric_limits<int>::max(), std::numeric_limits<int>::max()/4}));
+//    ui->splitter_worldmap->setSizes(QList<int>({std::numeric_limits<int>::max(), std::numeric_limits<int>::max()/4}));
+//    ui->splitter_worldmap->setSizes(QList<int>({std::numeric_limits<int>::max(), std::numeric_limits<int>::max()/4}));
+
+
+    int totalObs = 0;
+    const std::vector<VieVS::Scan> &scans = schedule_.getScans();
+    for(const VieVS::Scan &any: scans){
+        totalObs += any.getNObs();
+    }
+    ui->spinBox_observations->setValue(totalObs);
+    ui->spinBox_observations_total->setValue(totalObs);
+    ui->spinBox_scans->setValue(scans.size());
+    ui->spinBox_scans_total->setValue(scans.size());
+    ui->spinBox_sources->setValue(srcModel->rowCount());
+    ui->spinBox_sources_total->setValue(srcModel->rowCount());
+    ui->spinBox_stations->setValue(staModel->rowCount());
+    ui->spinBox_stations_total->setValue(staModel->rowCount());
+    ui->spinBox_baselines->setValue(schedule_.getNetwork().getNBls());
+    ui->spinBox_baselines_total->setValue(schedule_.getNetwork().getNBls());
+
+}
 
-//    comboBox2skyCoverage = new QSignalMapper(this);
+// -----------------------------------------------------------------------------
 
+void VieSchedpp_Analyser::setupSkyCoverage()
+{
     int stas = staModel->rowCount();
     if(stas == 2){
         setSkyCoverageLayout(1,2);
@@ -293,7 +368,10 @@ void VieSchedpp_Analyser::setup()
     }else if(stas >= 8){
         setSkyCoverageLayout(2,4);
     }
+}
 
+void VieSchedpp_Analyser::setupUVCoverage()
+{
     int srcs = srcModel->rowCount();
     if(srcs >= 2){
         setUVCoverageLayout(1,2);
@@ -314,28 +392,40 @@ void VieSchedpp_Analyser::setup()
 //    }else if(srcs >= 10){
 //        setUVCoverageLayout(2,5);
     }
+}
 
-//    ui->splitter_skyCoverage->setSizes(QList<int>({std::numeric_limits<int>::max(), std::numeric_limits<int>::max()/4}));
-//    ui->splitter_worldmap->setSizes(QList<int>({std::numeric_limits<int>::max(), std::numeric_limits<int>::max()/4}));
-//    ui->splitter_worldmap->setSizes(QList<int>({std::numeric_limits<int>::max(), std::numeric_limits<int>::max()/4}));
+bool VieSchedpp_Analyser::initializeTab(int idx)
+{
+    if(tabInitialized_.at(idx)){
+        return false;
+    }
+    tabInitialized_[idx] = true;
 
+    QElapsedTimer timer;
+    timer.start();
 
-    int totalObs = 0;
-    const std::vector<VieVS::Scan> &scans = schedule_.getScans();
-    for(const VieVS::Scan &any: scans){
-        totalObs += any.getNObs();
+    switch(idx){
+        case 0:{ setupSkyCoverage(); break; }
+        case 1:{ setupWorldmap(); break; }
+        case 2:{ setupUVCoverage(); break; }
+        case 3:{ setupSkymap(); break; }
+        case 4:{ statisticsGeneralSetup(); break; }
+        case 5:{ statisticsStationsSetup(); break; }
+        case 6:{ statisticsSourceSetup(); break; }
+        case 7:{ statisticsBaselineSetup(); break; }
+        default:{ break;}
     }
-    ui->spinBox_observations->setValue(totalObs);
-    ui->spinBox_observations_total->setValue(totalObs);
-    ui->spinBox_scans->setValue(scans.size());
-    ui->spinBox_scans_total->setValue(scans.size());
-    ui->spinBox_sources->setValue(srcModel->rowCount());
-    ui->spinBox_sources_total->setValue(srcModel->rowCount());
-    ui->spinBox_stations->setValue(staModel->rowCount());
-    ui->spinBox_stations_total->setValue(staModel->rowCount());
-    ui->spinBox_baselines->setValue(schedule_.getNetwork().getNBls());
-    ui->spinBox_baselines_total->setValue(schedule_.getNetwork().getNBls());
 
+    static const QStringList names = {"sky coverage", "world map", "uv coverage", "sky map",
+                                      "general statistics", "station statistics", "source statistics", "baseline statistics"};
+    statusBar()->showMessage(QString("%1 initialized in %2 ms").arg(names.value(idx)).arg(timer.elapsed()), 10000);
+    return true;
+}
+
+void VieSchedpp_Analyser::showTab(int idx)
+{
+    initializeTab(idx);
+    ui->stackedWidget->setCurrentIndex(idx);
 }
 
 // -----------------------------------------------------------------------------
@@ -358,7 +448,7 @@ void VieSchedpp_Analyser::on_horizontalSlider_start_valueChanged(int value)
     }else{
         updateDuration();
     }
-    updatePlotsAndModels();
+    scheduleUpdatePlotsAndModels();
 }
 
 void VieSchedpp_Analyser::on_horizontalSlider_end_valueChanged(int value)
@@ -379,7 +469,7 @@ void VieSchedpp_Analyser::on_horizontalSlider_end_valueChanged(int value)
     }else{
         updateDuration();
     }
-    updatePlotsAndModels();
+    scheduleUpdatePlotsAndModels();
 }
 
 void VieSchedpp_Analyser::on_dateTimeEdit_start_dateTimeChanged(const QDateTime &dateTime)
@@ -430,6 +520,8 @@ void VieSchedpp_Analyser::setSkyCoverageLayout(int rows, int columns)
             delete itm->layout();
         }
     }
+    skyCoverageSeries_ = QVector<SkyCoverageSeries>(rows*columns);
+    ++windowRevision_;
 
     int counter = 0;
     for(int i=0; i<rows; ++i){
@@ -452,6 +544,8 @@ void VieSchedpp_Analyser::setSkyCoverageLayout(int rows, int columns)
             chartView->setMouseTracking(true);
             Callout *callout = new Callout(chart);
             callout->hide();
+            PolarHeatmap *heatmap = new PolarHeatmap(chart);
+            heatmap->hide();
 
             QValueAxis *angularAxis = new QValueAxis();
             angularAxis->setTickCount(13); // First and last ticks are co-located on 0/360 angle.
@@ -564,6 +658,7 @@ void VieSchedpp_Analyser::on_pushButton_skyCov_screenshot_clicked()
     txt.append("/VieSchedpp_Analyzer_");
     txt.append(now.toString("yyyyMMddhhmmss"));
     render.setOutDir(txt);
+    render.enableAnimation(true);
 
     int result = render.exec();
     QVector<int> selected = render.selected();
@@ -578,73 +673,50 @@ void VieSchedpp_Analyser::on_pushButton_skyCov_screenshot_clicked()
         if(outDir.at(outDir.size() -1) != '/'){
             outDir.append('/');
         }
-
-        QGroupBox *box = qobject_cast<QGroupBox*>(ui->gridLayout_skyCoverage->itemAt(0)->widget());
-        QChartView *chartView = qobject_cast<QChartView*>(box->layout()->itemAt(1)->widget());
-        QComboBox *comboBox = qobject_cast<QComboBox*>(box->children().at(2));
-        int backupIdx = comboBox->currentIndex();
-        int backupStart = ui->horizontalSlider_start->value();
-        int backupEnd  = ui->horizontalSlider_end->value();
-        auto size = chartView->size();
-        chartView->resize(res.first,res.second);
+        bool animation = render.animation();
 
         QDir out(outDir);
         if(!out.exists()){
             QDir().mkpath(outDir);
         }
 
-        int c = 0;
+        // plot data is extracted once per station, images are rendered offscreen
+        QVector<OffscreenPlot::SkyCoverage> data;
+        QVector<OffscreenPlot::Job> jobs;
+        QVector<QString> animations;
         for(auto idx : selected){
-            comboBox->setCurrentIndex(idx);
+            QString name = staModel->item(idx,0)->text();
+            int staid = schedule_.getNetwork().getStation(name.toStdString()).getId();
+            data.append(OffscreenPlot::skyCoverage(schedule_, staid));
+            animations.append(QString("%1skyCov_%2.apng").arg(outDir).arg(name).replace('+','p'));
 
-            QString name = comboBox->currentText();
-
-            for(auto time : times){
-                int start = time.first;
-                int end = time.second;
-
-                ui->horizontalSlider_start->setValue(start);
-                ui->horizontalSlider_end->setValue(end);
+            for(int i=0; i<times.size(); ++i){
+                int start = times[i].first;
+                int end = times[i].second;
 
                 QString finalName;
-                if(start != 0 || end != duration){
+                if(animation){
+                    finalName = QString("%1skyCov_%2_%3.png").arg(outDir).arg(name).arg(i,5,10,QLatin1Char('0'));
+                }else if(start != 0 || end != duration){
                     finalName = QString("%1skyCov_%2_%3_%4.png").arg(outDir).arg(name).arg(start,5,10,QLatin1Char('0')).arg(end,5,10,QLatin1Char('0'));
                 }else{
                     finalName = QString("%1skyCov_%2.png").arg(outDir).arg(name);
                 }
                 finalName.replace('+','p');
 
-
-                QString date1 = ui->dateTimeEdit_start->dateTime().time().toString("HH:mm");
-                QString date2 = ui->dateTimeEdit_end->dateTime().time().toString("HH:mm");
-                if(date1 == date2){
-                    chartView->chart()->setTitle(name);
-                }else{
-                    chartView->chart()->setTitle(QString("%1 %2-%3").arg(name).arg(date1).arg(date2));
-                }
-                qApp->processEvents(QEventLoop::AllEvents);
-                chartView->grab().toImage().save(finalName);
-
-                ++c;
+                jobs.append({data.size()-1, start, end, exportTitle(name, start, end), finalName, false});
             }
-
         }
 
-        chartView->chart()->setTitle("");
-        chartView->resize(size);
-
-        comboBox->setCurrentIndex(backupIdx);
-        ui->horizontalSlider_start->setValue(backupStart);
-        ui->horizontalSlider_end->setValue(backupEnd);
-
-        QDir mydir(outDir);
-        QMessageBox mb;
-        QMessageBox::StandardButton reply = mb.information(this,"rendering",QString("plots successfully saved at\n").append(outDir),QMessageBox::Open,QMessageBox::Ok);
-        if(reply == QMessageBox::Open){
-            QDesktopServices::openUrl(QUrl(mydir.absolutePath()));
+        QSize size(res.first,res.second);
+        auto renderFrame = [&data, size](const OffscreenPlot::Job &job){
+            return OffscreenPlot::renderSkyCoverage(data.at(job.item), job.startTime, job.endTime, job.title, size);
+        };
+        if(animation){
+            exportAnimation(jobs, renderFrame, animations, render.frameDelay(), outDir);
+        }else{
+            exportImages(jobs, renderFrame, outDir);
         }
-
-
     }
 
 }
@@ -667,6 +739,7 @@ void VieSchedpp_Analyser::on_pushButton_uv_screenshot_clicked()
     txt.append("/VieSchedpp_Analyzer_");
     txt.append(now.toString("yyyyMMddhhmmss"));
     render.setOutDir(txt);
+    render.enableAnimation(true);
 
     int result = render.exec();
     QVector<int> selected = render.selected();
@@ -681,42 +754,49 @@ void VieSchedpp_Analyser::on_pushButton_uv_screenshot_clicked()
         if(outDir.at(outDir.size() -1) != '/'){
             outDir.append('/');
         }
-
-        QGroupBox *box = qobject_cast<QGroupBox*>(ui->gridLayout_uv_coverage->itemAt(0)->widget());
-        QChartView *chartView = qobject_cast<QChartView*>(box->layout()->itemAt(1)->widget());
-        QComboBox *comboBox = qobject_cast<QComboBox*>(box->children().at(2));
-        QComboBox *comboBox2 = qobject_cast<QComboBox*>(box->children().at(3));
-        int backupIdx = comboBox->currentIndex();
-        int backupStart = ui->horizontalSlider_start->value();
-        int backupEnd  = ui->horizontalSlider_end->value();
-        auto size = chartView->size();
-        chartView->resize(res.first,res.second);
+        bool animation = render.animation();
 
         QDir out(outDir);
         if(!out.exists()){
             QDir().mkpath(outDir);
         }
 
+        // band of the first uv plot, u and v are cached in meters
+        QString band = "-";
+        if(ui->gridLayout_uv_coverage->count() > 0){
+            QGroupBox *box = qobject_cast<QGroupBox*>(ui->gridLayout_uv_coverage->itemAt(0)->widget());
+            band = qobject_cast<QComboBox*>(box->children().at(3))->currentText();
+        }
+        QVector<double> scale;
+        if(band == "-"){
+            scale.append(1e-6);
+        }else{
+            for( double f : freqs_[band]){
+                scale.append(1e-6 * f / CMPS);
+            }
+        }
 
-        int c = 0;
+        // plot data is extracted once per source, images are rendered offscreen
+        const UVCoverageCache &cache = uvCache();
+        QVector<OffscreenPlot::UVCoverage> data;
+        QVector<OffscreenPlot::Job> jobs;
+        QVector<QString> animations;
         for(auto idx : selected){
-            comboBox->setCurrentIndex(idx);
-
-            QString name = comboBox->currentText();
-            QString name2 = comboBox2->currentText();
-            if(name2 != "-"){
-                name.append(" ").append(name2).append("-Band");
+            QString name = srcModel->item(idx,0)->text();
+            data.append(OffscreenPlot::uvCoverage(cache, idx, scale, band != "-"));
+            if(band != "-"){
+                name.append(" ").append(band).append("-Band");
             }
+            animations.append(QString("%1uv_%2.apng").arg(outDir).arg(name).replace('+','p').replace(' ','_'));
 
-            for(auto time : times){
-                int start = time.first;
-                int end = time.second;
-
-                ui->horizontalSlider_start->setValue(start);
-                ui->horizontalSlider_end->setValue(end);
+            for(int i=0; i<times.size(); ++i){
+                int start = times[i].first;
+                int end = times[i].second;
 
                 QString finalName;
-                if(start != 0 || end != duration){
+                if(animation){
+                    finalName = QString("%1uv_%2_%3.png").arg(outDir).arg(name).arg(i,5,10,QLatin1Char('0'));
+                }else if(start != 0 || end != duration){
                     finalName = QString("%1uv_%2_%3_%4.png").arg(outDir).arg(name).arg(start,5,10,QLatin1Char('0')).arg(end,5,10,QLatin1Char('0'));
                 }else{
                     finalName = QString("%1uv_%2.png").arg(outDir).arg(name);
@@ -724,36 +804,19 @@ void VieSchedpp_Analyser::on_pushButton_uv_screenshot_clicked()
                 finalName.replace('+','p');
                 finalName.replace(' ','_');
 
-                QString date1 = ui->dateTimeEdit_start->dateTime().time().toString("HH:mm");
-                QString date2 = ui->dateTimeEdit_end->dateTime().time().toString("HH:mm");
-                if(date1 == date2){
-                    chartView->chart()->setTitle(name);
-                }else{
-                    chartView->chart()->setTitle(QString("%1 %2-%3").arg(name).arg(date1).arg(date2));
-                }
-
-                qApp->processEvents(QEventLoop::AllEvents);
-                chartView->grab().toImage().save(finalName);
-
-                ++c;
+                jobs.append({data.size()-1, start, end, exportTitle(name, start, end), finalName, false});
             }
         }
 
-
-        chartView->chart()->setTitle("");
-        chartView->resize(size);
-
-        comboBox->setCurrentIndex(backupIdx);
-        ui->horizontalSlider_start->setValue(backupStart);
-        ui->horizontalSlider_end->setValue(backupEnd);
-
-        QDir mydir(outDir);
-        QMessageBox mb;
-        QMessageBox::StandardButton reply = mb.information(this,"rendering",QString("plots successfully saved at\n").append(outDir),QMessageBox::Open,QMessageBox::Ok);
-        if(reply == QMessageBox::Open){
-            QDesktopServices::openUrl(QUrl(mydir.absolutePath()));
+        QSize size(res.first,res.second);
+        auto renderFrame = [&data, size](const OffscreenPlot::Job &job){
+            return OffscreenPlot::renderUVCoverage(data.at(job.item), job.startTime, job.endTime, job.title, size);
+        };
+        if(animation){
+            exportAnimation(jobs, renderFrame, animations, render.frameDelay(), outDir);
+        }else{
+            exportImages(jobs, renderFrame, outDir);
         }
-
     }
 }
 
@@ -792,39 +855,23 @@ void VieSchedpp_Analyser::on_pushButton_el_screenshot_clicked()
             outDir.append('/');
         }
 
-        QChartView *chartView = qobject_cast<QChartView *>(ui->horizontalLayout_statistics_source->itemAt(0)->widget());
-        auto size = chartView->size();
-        chartView->resize(res.first,res.second);
-
         QDir out(outDir);
         if(!out.exists()){
             QDir().mkpath(outDir);
         }
-        ui->lineEdit_statistics_source_filter->setText("");
-        auto backupIdx = ui->treeView_statistics_source->currentIndex();
-        int c = 0;
-        for(auto idx : selected){
 
+        // plot data is extracted once per source, images are rendered offscreen
+        const ElevationTrackCache &cache = elevationCache();
+        QVector<OffscreenPlot::Elevation> data;
+        QVector<OffscreenPlot::Job> jobs;
+        for(auto idx : selected){
             QString name = srcModel->item(idx,0)->text();
-
-            int idxModel = 0;
-            for (int i=0; i<ui->treeView_statistics_source->model()->rowCount(); ++i){
-                if(ui->treeView_statistics_source->model()->index(i,0).data().toString() == name){
-                    idxModel = i;
-                    break;
-                }
-            }
-
-            ui->treeView_statistics_source->setCurrentIndex(ui->treeView_statistics_source->model()->index(idxModel,0));
-
+            data.append(OffscreenPlot::elevation(schedule_, cache, idx));
 
             for(auto time : times){
                 int start = time.first;
                 int end = time.second;
 
-                ui->horizontalSlider_start->setValue(start);
-                ui->horizontalSlider_end->setValue(end);
-
                 QString finalName;
                 if(start != 0 || end != duration){
                     finalName = QString("%1el_%2_%3_%4.png").arg(outDir).arg(name).arg(start,5,10,QLatin1Char('0')).arg(end,5,10,QLatin1Char('0'));
@@ -833,37 +880,182 @@ void VieSchedpp_Analyser::on_pushButton_el_screenshot_clicked()
                 }
                 finalName.replace('+','p');
 
-                QString date1 = ui->dateTimeEdit_start->dateTime().time().toString("HH:mm");
-                QString date2 = ui->dateTimeEdit_end->dateTime().time().toString("HH:mm");
-                if(date1 == date2){
-                    chartView->chart()->setTitle(name);
-                }else{
-                    chartView->chart()->setTitle(QString("%1 %2-%3").arg(name).arg(date1).arg(date2));
-                }
+                jobs.append({data.size()-1, start, end, exportTitle(name, start, end), finalName, false});
+            }
+        }
 
+        QSize size(res.first,res.second);
+        QDateTime sessionStart = sessionStart_;
+        exportImages(jobs, [&data, sessionStart, size](const OffscreenPlot::Job &job){
+            return OffscreenPlot::renderElevation(data.at(job.item), sessionStart, job.startTime, job.endTime, job.title, size);
+        }, outDir);
+    }
+}
+
+void VieSchedpp_Analyser::exportImages(QVector<OffscreenPlot::Job> &jobs,
+                                       const std::function<QImage (const OffscreenPlot::Job &)> &render,
+                                       const QString &outDir)
+{
+    QProgressDialog progress(this);
+    progress.setWindowTitle("rendering");
+    progress.setLabelText(QString("rendering %1 plots using %2 threads").arg(jobs.size()).arg(QThread::idealThreadCount()));
+    progress.setWindowModality(Qt::WindowModal);
 
-                qApp->processEvents(QEventLoop::AllEvents);
-                chartView->grab().toImage().save(finalName);
+    // rendering and png encoding of each image runs on the global thread pool
+    QFutureWatcher<void> watcher;
+    connect(&watcher, SIGNAL(finished()), &progress, SLOT(reset()));
+    connect(&progress, SIGNAL(canceled()), &watcher, SLOT(cancel()));
+    connect(&watcher, SIGNAL(progressRangeChanged(int,int)), &progress, SLOT(setRange(int,int)));
+    connect(&watcher, SIGNAL(progressValueChanged(int)), &progress, SLOT(setValue(int)));
 
-                ++c;
-            }
+    QElapsedTimer timer;
+    timer.start();
+    watcher.setFuture(QtConcurrent::map(jobs, [render](OffscreenPlot::Job &job){
+        job.saved = render(job).save(job.fileName, "PNG");
+    }));
+    progress.exec();
+    watcher.waitForFinished();
+
+    int saved = 0;
+    for(const auto &job : jobs){
+        if(job.saved){
+            ++saved;
         }
+    }
+    statusBar()->showMessage(QString("%1 plots saved in %2 s").arg(saved).arg(timer.elapsed()/1000.0), 10000);
 
-        chartView->chart()->setTitle("");
-        chartView->resize(size);
+    if(watcher.isCanceled()){
+        showExportResult(QString("rendering canceled, %1 of %2 plots saved at\n").arg(saved).arg(jobs.size()), false, outDir);
+    }else if(saved != jobs.size()){
+        showExportResult(QString("%1 of %2 plots could not be saved at\n").arg(jobs.size()-saved).arg(jobs.size()), true, outDir);
+    }else{
+        showExportResult("plots successfully saved at\n", false, outDir);
+    }
+}
+
+void VieSchedpp_Analyser::exportAnimation(QVector<OffscreenPlot::Job> &jobs,
+                                          const std::function<QImage (const OffscreenPlot::Job &)> &render,
+                                          const QVector<QString> &animations, int delay, const QString &outDir)
+{
+    QProgressDialog progress(this);
+    progress.setWindowTitle("rendering");
+    progress.setLabelText(QString("rendering %1 frames using %2 threads").arg(jobs.size()).arg(QThread::idealThreadCount()));
+    progress.setWindowModality(Qt::WindowModal);
+    progress.setRange(0, jobs.size());
+    progress.setMinimumDuration(0);
+
+    QFutureWatcher<void> watcher;
+    QEventLoop loop;
+    connect(&watcher, SIGNAL(finished()), &loop, SLOT(quit()));
+    connect(&progress, SIGNAL(canceled()), &watcher, SLOT(cancel()));
+
+    // frames are rendered and encoded concurrently in chunks and appended to the animation in order afterwards,
+    // only the encoded frames of one chunk are kept in memory
+    int chunk = 2*QThread::idealThreadCount();
+    QVector<QByteArray> encoded(chunk);
+    QVector<int> indices;
+    OffscreenPlot::Job *jobData = jobs.data();
+    QByteArray *encodedData = encoded.data();
+
+    AnimatedPngWriter writer;
+    int item = -1;
+    int failed = 0;
+    int nAnimations = 0;
+    QElapsedTimer timer;
+    timer.start();
+    for(int first=0; first<jobs.size(); first+=chunk){
+        int n = std::min(chunk, jobs.size()-first);
+        indices.resize(n);
+        std::iota(indices.begin(), indices.end(), first);
+
+        watcher.setFuture(QtConcurrent::map(indices, [jobData, encodedData, &render, first](int i){
+            OffscreenPlot::Job &job = jobData[i];
+            QByteArray &png = encodedData[i-first];
+            png.clear();
+            QBuffer buffer(&png);
+            buffer.open(QIODevice::WriteOnly);
+            job.saved = render(job).save(&buffer, "PNG");
+            if(job.saved){
+                QFile file(job.fileName);
+                job.saved = file.open(QIODevice::WriteOnly) && file.write(png) == png.size();
+            }
+        }));
+        loop.exec();
+        watcher.waitForFinished();
+        if(watcher.isCanceled()){
+            break;
+        }
 
-        ui->treeView_statistics_source->setCurrentIndex(backupIdx);
+        for(int i=first; i<first+n; ++i){
+            const OffscreenPlot::Job &job = jobs.at(i);
+            if(job.item != item){
+                if(writer.isOpen() && !writer.close()){
+                    ++failed;
+                }
+                item = job.item;
+                int nFrames = std::count_if(jobs.constBegin()+i, jobs.constEnd(),
+                                            [item](const OffscreenPlot::Job &any){ return any.item == item; });
+                ++nAnimations;
+                if(!writer.open(animations.at(item), nFrames, delay)){
+                    ++failed;
+                }
+            }
+            if(job.saved && writer.isOpen() && !writer.addFrame(encoded.at(i-first))){
+                writer.close();
+                ++failed;
+            }
+        }
+        progress.setValue(first+n);
+    }
+    if(writer.isOpen() && !writer.close()){
+        ++failed;
+    }
+    progress.reset();
 
-        QDir mydir(outDir);
-        QMessageBox mb;
-        QMessageBox::StandardButton reply = mb.information(this,"rendering",QString("plots successfully saved at\n").append(outDir),QMessageBox::Open,QMessageBox::Ok);
-        if(reply == QMessageBox::Open){
-            QDesktopServices::openUrl(QUrl(mydir.absolutePath()));
+    int saved = 0;
+    for(const auto &job : jobs){
+        if(job.saved){
+            ++saved;
         }
+    }
+    statusBar()->showMessage(QString("%1 frames saved in %2 s").arg(saved).arg(timer.elapsed()/1000.0), 10000);
 
+    if(watcher.isCanceled()){
+        showExportResult(QString("rendering canceled, %1 of %2 frames saved at\n").arg(saved).arg(jobs.size()), false, outDir);
+    }else if(saved != jobs.size() || failed > 0){
+        showExportResult(QString("%1 of %2 frames and %3 of %4 animations could not be saved at\n")
+                         .arg(jobs.size()-saved).arg(jobs.size()).arg(failed).arg(nAnimations), true, outDir);
+    }else{
+        showExportResult("animations successfully saved at\n", false, outDir);
     }
 }
 
+void VieSchedpp_Analyser::showExportResult(const QString &text, bool warning, const QString &outDir)
+{
+    QDir mydir(outDir);
+    QMessageBox mb;
+    QMessageBox::StandardButton reply;
+    if(warning){
+        reply = mb.warning(this,"rendering",QString(text).append(outDir),QMessageBox::Open,QMessageBox::Ok);
+    }else{
+        reply = mb.information(this,"rendering",QString(text).append(outDir),QMessageBox::Open,QMessageBox::Ok);
+    }
+    if(reply == QMessageBox::Open){
+        QDesktopServices::openUrl(QUrl(mydir.absolutePath()));
+    }
+}
+
+QString VieSchedpp_Analyser::exportTitle(const QString &name, int start, int end) const
+{
+    QString date1 = sessionStart_.addSecs(start).time().toString("HH:mm");
+    QString date2 = sessionStart_.addSecs(end).time().toString("HH:mm");
+    if(date1 == date2){
+        return name;
+    }
+    return QString("%1 %2-%3").arg(name).arg(date1).arg(date2);
+}
+
+
 
 
 void VieSchedpp_Analyser::increment(QGridLayout *layout, int n)
@@ -1042,6 +1234,12 @@ void VieSchedpp_Analyser::updateSkyCoverage(int idx, QString name)
 //    QList<std::tuple<int, double, double, int>> list = qtUtil::pointingVectors2Lists(thisSkyCoverage.getPointingVectors());
 
     QScatterSeriesExtended *data = new QScatterSeriesExtended();
+    QVector<SkyCoverageRaster::Pointing> pointings;
+    pointings.reserve(list.size());
+    WindowPoints points;
+    points.startTime.reserve(list.size());
+    points.endTime.reserve(list.size());
+    points.group.reserve(list.size());
     for(const auto &any : list){
         double unaz = any.az;
         double az = VieVS::util::wrap2twoPi(unaz)*rad2deg;
@@ -1050,6 +1248,26 @@ void VieSchedpp_Analyser::updateSkyCoverage(int idx, QString name)
         }
         VieVS::AbstractCableWrap::CableWrapFlag flag = thisSta.getCableWrap().cableWrapFlag(unaz);
         data->append(az, 90-any.el*rad2deg, any.startTime, any.endTime, flag, any.srcid, any.nsta);
+        pointings.append(SkyCoverageRaster::Pointing{az, 90-any.el*rad2deg, any.startTime, any.endTime});
+
+        char group = 0;
+        switch(flag){
+            case VieVS::AbstractCableWrap::CableWrapFlag::n:{
+                group = 0;
+                break;
+            }
+            case VieVS::AbstractCableWrap::CableWrapFlag::ccw:{
+                group = 1;
+                break;
+            }
+            case VieVS::AbstractCableWrap::CableWrapFlag::cw:{
+                group = 2;
+                break;
+            }
+        }
+        points.startTime.append(any.startTime);
+        points.endTime.append(any.endTime);
+        points.group.append(group);
     }
     data->setBrush(Qt::gray);
     data->setMarkerSize(7);
@@ -1099,83 +1317,76 @@ void VieSchedpp_Analyser::updateSkyCoverage(int idx, QString name)
 
     chart->legend()->setMarkerShape(QLegend::MarkerShapeFromSeries);
 
+    SkyCoverageSeries &handles = skyCoverageSeries_[idx];
+    handles.data = data;
+    handles.n = n;
+    handles.ccw = ccw;
+    handles.cw = cw;
+    handles.selected = selected;
+    handles.points = points;
+    ++windowRevision_;
+
+    skyCoverageHeatmap(chart)->setPointings(pointings);
+
     updateSkyCoverageTimes(idx);
 }
 
 void VieSchedpp_Analyser::updateSkyCoverageTimes()
 {
-    for(int i=0; i<ui->gridLayout_skyCoverage->count(); ++i){
-        updateSkyCoverageTimes(i);
+    // the pointings inside the window are usually already selected by the window update on the worker thread
+    bool useJob = windowJobValid() && windowJob_.skyCoverageIds.size() == skyCoverageSeries_.size();
+    int start = ui->horizontalSlider_start->value();
+    int end = ui->horizontalSlider_end->value();
+    bool heatmapMode = ui->checkBox_skyCoverageHeatmap->isChecked();
+
+    for(int i=0; i<skyCoverageSeries_.size(); ++i){
+        if(useJob){
+            setSkyCoverageTimes(i, windowJob_.skyCoverageIds.at(i));
+        }else{
+            QVector<QVector<int>> ids(3);
+            if(!heatmapMode){
+                pointsInWindow(skyCoverageSeries_.at(i).points, start, end, ids);
+            }
+            setSkyCoverageTimes(i, ids);
+        }
     }
+    on_treeView_skyCoverage_sources_clicked(QModelIndex());
 }
 
 void VieSchedpp_Analyser::updateSkyCoverageTimes(int idx)
 {
-    QGroupBox *box = qobject_cast<QGroupBox*>(ui->gridLayout_skyCoverage->itemAt(idx)->widget());
-    QChartView *chartView = qobject_cast<QChartView*>(box->layout()->itemAt(1)->widget());
-    QChart *chart = chartView->chart();
+    int start = ui->horizontalSlider_start->value();
+    int end = ui->horizontalSlider_end->value();
 
-    QList<QAbstractSeries *> series = chart->series();
-    if(series.empty()){
-        return;
+    QVector<QVector<int>> ids(3);
+    if(!ui->checkBox_skyCoverageHeatmap->isChecked()){
+        pointsInWindow(skyCoverageSeries_.at(idx).points, start, end, ids);
     }
-    QScatterSeriesExtended * data;
-    QScatterSeriesExtended * ccw;
-    QScatterSeriesExtended * cw;
-    QScatterSeriesExtended * n;
-    QScatterSeriesExtended * selected;
+    setSkyCoverageTimes(idx, ids);
 
-    for(const auto &any:series){
-        if(any->name() == "outside timespan"){
-            data = static_cast<QScatterSeriesExtended *>(any);
-        }
-        if(any->name() == "ccw"){
-            ccw = static_cast<QScatterSeriesExtended *>(any);
-        }
-        if(any->name() == "cw"){
-            cw = static_cast<QScatterSeriesExtended *>(any);
-        }
-        if(any->name() == "n"){
-            n = static_cast<QScatterSeriesExtended *>(any);
-        }
-        if(any->name() == "selected"){
-            selected = static_cast<QScatterSeriesExtended *>(any);
-        }
-    }
-
-    ccw->clear();
-    cw->clear();
-    n->clear();
-    selected->clear();
-
-    int start = ui->horizontalSlider_start->value();
-    int end = ui->horizontalSlider_end->value();
+    on_treeView_skyCoverage_sources_clicked(QModelIndex());
+}
 
-    for(int i=0; i<data->count(); ++i){
-        bool flag1 = data->getStartTime(i) >= start && data->getStartTime(i) <= end;
-        bool flag2 = data->getEndTime(i) >= start && data->getEndTime(i) <= end;
-        bool flag3 = data->getStartTime(i) <= start && data->getEndTime(i) >= end;
-        bool flag = flag1 || flag2 || flag3;
+void VieSchedpp_Analyser::setSkyCoverageTimes(int idx, const QVector<QVector<int>> &ids)
+{
+    const SkyCoverageSeries &handles = skyCoverageSeries_.at(idx);
+    if(handles.data == nullptr){
+        return;
+    }
+    QScatterSeriesExtended *data = handles.data;
 
-        if(flag){
-            switch(data->getCableWrapFlag(i)){
-                case VieVS::AbstractCableWrap::CableWrapFlag::n:{
-                    n->append(data->at(i).x(), data->at(i).y(), data->getStartTime(i), data->getEndTime(i), data->getCableWrapFlag(i), data->getSrcid(i), data->getNSta(i));
-                    break;
-                }
-                case VieVS::AbstractCableWrap::CableWrapFlag::ccw:{
-                    ccw->append(data->at(i).x(), data->at(i).y(), data->getStartTime(i), data->getEndTime(i), data->getCableWrapFlag(i), data->getSrcid(i), data->getNSta(i));
-                    break;
-                }
-                case VieVS::AbstractCableWrap::CableWrapFlag::cw:{
-                    cw->append(data->at(i).x(), data->at(i).y(), data->getStartTime(i), data->getEndTime(i), data->getCableWrapFlag(i), data->getSrcid(i), data->getNSta(i));
-                    break;
-                }
-            }
-        }
+    // heatmap mode: the raster is updated incrementally and replaces all single pointings
+    bool heatmapMode = ui->checkBox_skyCoverageHeatmap->isChecked();
+    PolarHeatmap *heatmap = skyCoverageHeatmap(data->chart());
+    data->setVisible(!heatmapMode);
+    heatmap->setVisible(heatmapMode);
+    if(heatmapMode){
+        heatmap->setWindow(ui->horizontalSlider_start->value(), ui->horizontalSlider_end->value());
     }
 
-    on_treeView_skyCoverage_sources_clicked(QModelIndex());
+    handles.n->replaceWith(data, ids.at(0));
+    handles.ccw->replaceWith(data, ids.at(1));
+    handles.cw->replaceWith(data, ids.at(2));
 }
 
 void VieSchedpp_Analyser::skyCoverageHovered(QPointF point, bool flag)
@@ -1246,45 +1457,51 @@ void VieSchedpp_Analyser::on_treeView_skyCoverage_sources_clicked(const QModelIn
         ids.push_back(id);
     }
 
-    for(int idx = 0; idx < ui->gridLayout_skyCoverage->count(); ++idx){
-        QGroupBox *box = qobject_cast<QGroupBox*>(ui->gridLayout_skyCoverage->itemAt(idx)->widget());
-        QChartView *chartView = qobject_cast<QChartView*>(box->layout()->itemAt(1)->widget());
-        QChart *chart = chartView->chart();
-
-        QList<QAbstractSeries *> series = chart->series();
-        QScatterSeriesExtended * data;
-        QScatterSeriesExtended * selected;
+    int start = ui->horizontalSlider_start->value();
+    int end = ui->horizontalSlider_end->value();
 
-        for(const auto &any:series){
-            if(any->name() == "outside timespan"){
-                data = static_cast<QScatterSeriesExtended *>(any);
-            }
-            if(any->name() == "selected"){
-                selected = static_cast<QScatterSeriesExtended *>(any);
-            }
+    for(const SkyCoverageSeries &handles : skyCoverageSeries_){
+        QScatterSeriesExtended *data = handles.data;
+        if(data == nullptr){
+            continue;
         }
-        selected->clear();
 
-        int start = ui->horizontalSlider_start->value();
-        int end = ui->horizontalSlider_end->value();
+        QVector<int> selected;
+        if(!ids.isEmpty()){
+            for(int i=0; i<data->count(); ++i){
 
-        for(int i=0; i<data->count(); ++i){
+                bool flag1 = data->getStartTime(i) >= start && data->getStartTime(i) <= end;
+                bool flag2 = data->getEndTime(i) >= start && data->getEndTime(i) <= end;
+                bool flag3 = data->getStartTime(i) <= start && data->getEndTime(i) >= end;
+                bool flag = flag1 || flag2 || flag3;
 
-            bool flag1 = data->getStartTime(i) >= start && data->getStartTime(i) <= end;
-            bool flag2 = data->getEndTime(i) >= start && data->getEndTime(i) <= end;
-            bool flag3 = data->getStartTime(i) <= start && data->getEndTime(i) >= end;
-            bool flag = flag1 || flag2 || flag3;
-
-            if(flag){
-                if( ids.indexOf(data->getSrcid(i)) != -1){
-                    selected->append(data->at(i).x(), data->at(i).y(), data->getStartTime(i), data->getEndTime(i), data->getCableWrapFlag(i), data->getSrcid(i), data->getNSta(i));
+                if(flag){
+                    if( ids.indexOf(data->getSrcid(i)) != -1){
+                        selected.append(i);
+                    }
                 }
             }
         }
+        handles.selected->replaceWith(data, selected);
     }
 }
 
 
+void VieSchedpp_Analyser::on_checkBox_skyCoverageHeatmap_toggled(bool checked)
+{
+    updateSkyCoverageTimes();
+}
+
+PolarHeatmap *VieSchedpp_Analyser::skyCoverageHeatmap(QChart *chart)
+{
+    for(QGraphicsItem *childItem: chart->childItems()){
+        if(PolarHeatmap *heatmap = dynamic_cast<PolarHeatmap *>(childItem)){
+            return heatmap;
+        }
+    }
+    return nullptr;
+}
+
 void VieSchedpp_Analyser::on_checkBox_skyCoverageLegend_toggled(bool checked)
 {
     if(ui->checkBox_skyCoverageLegend->isChecked()){
@@ -1325,6 +1542,7 @@ void VieSchedpp_Analyser::setupWorldmap()
 
     QScatterSeries *observingStations = new QScatterSeries(worldChart);
     observingStations->setName("observing stations");
+    observingStations_ = observingStations;
     QImage img(":/icons/icons/station_white.png");
     img = img.scaled(40,40);
     observingStations->setBrush(QBrush(img));
@@ -1335,12 +1553,16 @@ void VieSchedpp_Analyser::setupWorldmap()
     connect(selectedStations,SIGNAL(hovered(QPointF,bool)),this,SLOT(worldmap_hovered(QPointF,bool)));
     connect(observingStations,SIGNAL(hovered(QPointF,bool)),this,SLOT(worldmap_hovered(QPointF,bool)));
 
-    const std::vector<VieVS::Station> &stations = schedule_.getNetwork().getStations();
-    for(const VieVS::Station &station : stations){
-        double lat = station.getPosition().getLat()*rad2deg;
-        double lon = station.getPosition().getLon()*rad2deg;
-        selectedStations->append(lon,lat);
+    selectedStations->replace(stationIndex_.points());
+
+    // baseline id per name, the series of a baseline are named like the baseline
+    QHash<QString, int> blids;
+    for(const VieVS::Baseline &any : schedule_.getNetwork().getBaselines()){
+        blids.insert(QString::fromStdString(any.getName()), static_cast<int>(any.getId()));
     }
+    worldmapBaselines_ = QVector<QList<QLineSeries *>>(baselineRow_.size());
+
+    const std::vector<VieVS::Station> &stations = schedule_.getNetwork().getStations();
     for(int i=0; i<stations.size(); ++i){
         double lat1 = stations.at(i).getPosition().getLat()*rad2deg;
         double lon1 = stations.at(i).getPosition().getLon()*rad2deg;
@@ -1352,12 +1574,16 @@ void VieSchedpp_Analyser::setupWorldmap()
             QString name2 = QString::fromStdString(stations.at(j).getAlternativeName());
 
             QList<QLineSeries *>series = qtUtil::baselineSeries(lat1,lon1,name1,lat2,lon2,name2);
+            int blid = blids.value(QString("%1-%2").arg(name1).arg(name2), -1);
             for(const auto &any: series){
                 worldChart->addSeries(any);
                 any->attachAxis(worldChart->axisX());
                 any->attachAxis(worldChart->axisY());
                 connect(any,SIGNAL(hovered(QPointF,bool)),this,SLOT(worldmap_baseline_hovered(QPointF,bool)));
 
+                if(blid != -1){
+                    worldmapBaselines_[blid].append(any);
+                }
             }
 
         }
@@ -1392,33 +1618,26 @@ void VieSchedpp_Analyser::worldmap_hovered(QPointF point, bool state)
                 QString scans;
                 QString obs;
                 const std::vector<VieVS::Station> &stations = schedule_.getNetwork().getStations();
-                for(const VieVS::Station &station : stations){
-                    double y = station.getPosition().getLat()*rad2deg;
-                    double x = station.getPosition().getLon()*rad2deg;
-
-                    auto dx = x-point.x();
-                    auto dy = y-point.y();
-                    if(dx*dx+dy*dy < 1e-3){
-                        if(sta.size()==0){
-                            sta.append(QString("%1 (%2)").arg(QString::fromStdString(station.getName())).arg(QString::fromStdString(station.getAlternativeName())));
-                        }else{
-                            sta.append(QString(", %1 (%2)").arg(QString::fromStdString(station.getName())).arg(QString::fromStdString(station.getAlternativeName())));
-                        }
-                        auto stations = staModel->findItems(QString::fromStdString(station.getName()));
-                        int row = stations.at(0)->row();
-                        QString nscans = staModel->item(row,2)->text();
-                        QString nobs = staModel->item(row,3)->text();
-
-                        if(scans.size()==0){
-                            scans.append(QString("%1").arg(nscans));
-                        }else{
-                            scans.append(QString(", %1").arg(nscans));
-                        }
-                        if(obs.size()==0){
-                            obs.append(QString("%1").arg(nobs));
-                        }else{
-                            obs.append(QString(", %1").arg(nobs));
-                        }
+                // rows of staModel are in station id order
+                for(int staid : stationIndex_.within(point, std::sqrt(1e-3))){
+                    const VieVS::Station &station = stations.at(staid);
+                    if(sta.size()==0){
+                        sta.append(QString("%1 (%2)").arg(QString::fromStdString(station.getName())).arg(QString::fromStdString(station.getAlternativeName())));
+                    }else{
+                        sta.append(QString(", %1 (%2)").arg(QString::fromStdString(station.getName())).arg(QString::fromStdString(station.getAlternativeName())));
+                    }
+                    QString nscans = staModel->item(staid,2)->text();
+                    QString nobs = staModel->item(staid,3)->text();
+
+                    if(scans.size()==0){
+                        scans.append(QString("%1").arg(nscans));
+                    }else{
+                        scans.append(QString(", %1").arg(nscans));
+                    }
+                    if(obs.size()==0){
+                        obs.append(QString("%1").arg(nobs));
+                    }else{
+                        obs.append(QString(", %1").arg(nobs));
                     }
                 }
 
@@ -1501,17 +1720,7 @@ void VieSchedpp_Analyser::setupSkymap()
     connect(selectedSources,SIGNAL(hovered(QPointF,bool)),this,SLOT(skymap_hovered(QPointF,bool)));
     connect(observedSources,SIGNAL(hovered(QPointF,bool)),this,SLOT(skymap_hovered(QPointF,bool)));
 
-    const std::vector<VieVS::Source> &sources = schedule_.getSources();
-    for(const VieVS::Source &source : sources){
-        double ra = source.getRa();
-        double lambda = ra;
-
-        double phi = source.getDe();
-
-        auto xy = qtUtil::radec2xy(lambda, phi);
-
-        selectedSources->append(xy.first, xy.second);
-    }
+    selectedSources->replace(sourceIndex_.points());
     Callout *callout = new Callout(skyChart);
     callout->hide();
 
@@ -1533,23 +1742,16 @@ void VieSchedpp_Analyser::skymap_hovered(QPointF point, bool state)
         if(Callout *skyMapCallout = dynamic_cast<Callout *>(childItem)){
 
             if (state) {
-                const std::vector<VieVS::Source> &sources = schedule_.getSources();
                 QString text;
-                for(const VieVS::Source &source : sources){
+                int srcid = sourceIndex_.nearest(point, std::sqrt(1e-3));
+                if(srcid != -1){
+                    const VieVS::Source &source = schedule_.getSources().at(srcid);
                     double ra = source.getRa();
                     double dec = source.getDe();
-
-                    auto xy = qtUtil::radec2xy(ra, dec);
-
-                    auto dx = xy.first-point.x();
-                    auto dy = xy.second-point.y();
-                    if(dx*dx+dy*dy < 1e-3){
-                        if(source.hasAlternativeName()){
-                            text = QString("%1 (%2)\n#scans %3 \n#obs %4\nra %5 [deg] \ndec %6 [deg] ").arg(QString::fromStdString(source.getName())).arg(QString::fromStdString(source.getAlternativeName())).arg(source.getNscans()).arg(source.getNObs()).arg(ra*rad2deg).arg(dec*rad2deg);
-                        }else{
-                            text = QString("%1 \n#scans %2 \n#obs %3\nra %4 [deg] \ndec %5 [deg] ").arg(QString::fromStdString(source.getName())).arg(source.getNscans()).arg(source.getNObs()).arg(ra*rad2deg).arg(dec*rad2deg);
-                        }
-                        break;
+                    if(source.hasAlternativeName()){
+                        text = QString("%1 (%2)\n#scans %3 \n#obs %4\nra %5 [deg] \ndec %6 [deg] ").arg(QString::fromStdString(source.getName())).arg(QString::fromStdString(source.getAlternativeName())).arg(source.getNscans()).arg(source.getNObs()).arg(ra*rad2deg).arg(dec*rad2deg);
+                    }else{
+                        text = QString("%1 \n#scans %2 \n#obs %3\nra %4 [deg] \ndec %5 [deg] ").arg(QString::fromStdString(source.getName())).arg(source.getNscans()).arg(source.getNObs()).arg(ra*rad2deg).arg(dec*rad2deg);
                     }
                 }
 
@@ -1713,11 +1915,15 @@ void VieSchedpp_Analyser::statisticsGeneralSetup()
     ui->label_general_title->setStyleSheet("font-weight: bold");
 
     int nsta = schedule_.getNetwork().getNSta();
-    QVector<int> nstaPerScan(nsta+1,0);
+    // one bin per number of stations
+    staPerScanHistogram_.setEdges(Histogram::uniformEdges(0, 1, nsta+1));
 
+    QVector<double> nstas;
     for(const VieVS::Scan &scan : schedule_.getScans()){
-        ++nstaPerScan[scan.getNSta()];
+        nstas.append(scan.getNSta());
     }
+    staPerScanHistogram_.fill(nstas);
+    const QVector<int> &nstaPerScan = staPerScanHistogram_.counts();
 
     QPieSeries * staPerScan = new QPieSeries();
     staPerScan->setName("#stations per scan");
@@ -1774,18 +1980,19 @@ void VieSchedpp_Analyser::statisticsGeneralSetup()
     int newMax = maxObsDur/10*10+10;
     int cache = (1+newMax/100)*10;
 
+    QVector<double> edges = {0};
     int upper_bound = cache;
     while (upper_bound < newMax+cache){
-        histogram_upperLimits_.append(upper_bound);
+        edges.append(upper_bound);
         upper_bound += cache;
     }
+    obsDurationHistogram_.setEdges(edges);
 
-    int lower = 0;
     QStringList labels;
-    for(int i=0; i<histogram_upperLimits_.count(); ++i){
-        int higher = histogram_upperLimits_.at(i)-1;
+    for(int i=0; i<obsDurationHistogram_.nBins(); ++i){
+        int lower = static_cast<int>(edges.at(i));
+        int higher = static_cast<int>(edges.at(i+1))-1;
         labels << QString("%0-%1").arg(lower).arg(higher);
-        lower = higher+1;
     }
     axisX->append(labels);
     axisX->setLabelsAngle(-90);
@@ -1864,70 +2071,210 @@ void VieSchedpp_Analyser::timePerObservation_hovered(bool state, int idx)
 
 }
 
-void VieSchedpp_Analyser::updatePlotsAndModels()
+void VieSchedpp_Analyser::scheduleUpdatePlotsAndModels()
 {
-    int nsta = staModel->rowCount();
-    QVector<int> scansStation(nsta,0);
-    QVector<int> obsStation(nsta,0);
-    int nsrc = srcModel->rowCount();
-    QVector<int> scansSource(nsrc,0);
-    QVector<int> obsSource(nsrc,0);
-    int nbl = blModel->rowCount();
-    QVector<int> scansBaseline(nbl,0);
+    // a running update belongs to an outdated window, it is stopped and restarted in windowUpdateFinished()
+    if(windowWatcher_->isRunning()){
+        windowCancel_.fetchAndStoreRelaxed(1);
+    }
+    windowTimer_->start();
+}
 
-    int start = ui->horizontalSlider_start->value();
-    int end = ui->horizontalSlider_end->value();
+void VieSchedpp_Analyser::startWindowUpdate()
+{
+    if(windowWatcher_->isRunning()){
+        // restarted in windowUpdateFinished()
+        return;
+    }
+    windowCancel_.fetchAndStoreRelaxed(0);
+    prepareWindowJob();
+    windowWatcher_->setFuture(QtConcurrent::run([this](){
+        computeWindow(windowJob_);
+    }));
+}
 
-    for(const VieVS::Scan &scan : schedule_.getScans()){
-        bool flag1 = scan.getTimes().getObservingTime(VieVS::Timestamp::start) >= start && scan.getTimes().getObservingTime(VieVS::Timestamp::start) <= end;
-        bool flag2 = scan.getTimes().getObservingTime(VieVS::Timestamp::end)   >= start && scan.getTimes().getObservingTime(VieVS::Timestamp::end) <= end;
-        bool flag3 = scan.getTimes().getObservingTime(VieVS::Timestamp::start) <= start && scan.getTimes().getObservingTime(VieVS::Timestamp::end) >= end;
+void VieSchedpp_Analyser::prepareWindowJob()
+{
+    WindowJob &job = windowJob_;
+    job.start = ui->horizontalSlider_start->value();
+    job.end = ui->horizontalSlider_end->value();
+    job.revision = windowRevision_;
+    job.heatmap = ui->checkBox_skyCoverageHeatmap->isChecked();
+    job.canceled = false;
+    job.skyCoverage.clear();
+    job.uv.clear();
+    job.skyCoverageIds.clear();
+    job.uvIds.clear();
+
+    // only the charts of the visible tab are updated, the other tabs are updated when they are shown
+    int idx = ui->stackedWidget->currentIndex();
+    if(idx == 0){
+        for(const SkyCoverageSeries &handles : skyCoverageSeries_){
+            job.skyCoverage.append(handles.points);
+        }
+    }
+    if(idx == 2){
+        for(const UVSeries &handles : uvSeries_){
+            job.uv.append(handles.points);
+        }
+    }
+    job.histograms = idx == 4;
+    job.staPerScan = staPerScanHistogram_;
+    job.obsDuration = obsDurationHistogram_;
+}
+
+void VieSchedpp_Analyser::computeWindow(WindowJob &job)
+{
+    // runs on the worker thread, only the copied input, the scan index and the (constant) schedule are accessed
+    scanIndex_.setWindow(job.start, job.end);
+
+    for(const WindowPoints &points : job.skyCoverage){
+        QVector<QVector<int>> ids(3);
+        if(!job.heatmap && !pointsInWindow(points, job.start, job.end, ids, &windowCancel_)){
+            job.canceled = true;
+            return;
+        }
+        job.skyCoverageIds.append(ids);
+    }
+    for(const WindowPoints &points : job.uv){
+        QVector<QVector<int>> ids(1);
+        if(!pointsInWindow(points, job.start, job.end, ids, &windowCancel_)){
+            job.canceled = true;
+            return;
+        }
+        job.uvIds.append(ids.at(0));
+    }
+    if(job.histograms && !fillWindowHistograms(job.start, job.end, job.staPerScan, job.obsDuration, &windowCancel_)){
+        job.canceled = true;
+        return;
+    }
+}
+
+bool VieSchedpp_Analyser::pointsInWindow(const WindowPoints &points, int start, int end, QVector<QVector<int>> &ids,
+                                         const QAtomicInt *cancel)
+{
+    int n = points.startTime.size();
+    for(int i=0; i<n; ++i){
+        if(cancel != nullptr && (i & 4095) == 0 && cancel->loadAcquire() != 0){
+            return false;
+        }
+        int tstart = points.startTime.at(i);
+        int tend = points.endTime.at(i);
+        bool flag1 = tstart >= start && tstart <= end;
+        bool flag2 = tend   >= start && tend <= end;
+        bool flag3 = tstart <= start && tend >= end;
         bool flag = flag1 || flag2 || flag3;
 
         if(flag){
-            ++scansSource[scan.getSourceId()];
-            for(int i = 0; i<scan.getNSta(); ++i){
-                unsigned int pvStart = scan.getPointingVector(i,VieVS::Timestamp::start).getTime();
-                unsigned int pvEnd = scan.getPointingVector(i,VieVS::Timestamp::end).getTime();
-                unsigned int obsStart = scan.getTimes().getObservingTime(i,VieVS::Timestamp::start);
-                unsigned int obsEnd = scan.getTimes().getObservingTime(i,VieVS::Timestamp::end);
-
-                bool flag11 = scan.getPointingVector(i,VieVS::Timestamp::start).getTime() >= start && scan.getPointingVector(i,VieVS::Timestamp::start).getTime() <= end;
-                bool flag21 = scan.getPointingVector(i,VieVS::Timestamp::end).getTime()   >= start && scan.getPointingVector(i,VieVS::Timestamp::end).getTime()   <= end;
-                bool flag31 = scan.getPointingVector(i,VieVS::Timestamp::start).getTime() <= start && scan.getPointingVector(i,VieVS::Timestamp::end).getTime()   >= end;
-                bool flag01 = flag11 || flag21 || flag31;
-
-                if(flag01){
-                    ++scansStation[scan.getPointingVector(i).getStaid()];
-                }
+            int group = points.group.isEmpty() ? 0 : points.group.at(i);
+            ids[group].append(i);
+        }
+    }
+    return true;
+}
+
+bool VieSchedpp_Analyser::fillWindowHistograms(int start, int end, Histogram &staPerScan, Histogram &obsDuration,
+                                               const QAtomicInt *cancel) const
+{
+    const std::vector<VieVS::Scan> &scans = schedule_.getScans();
+
+    if(!staPerScan.isCached(start, end)){
+        QVector<double> nstas;
+        for(size_t k=0; k<scans.size(); ++k){
+            if(cancel != nullptr && (k & 1023) == 0 && cancel->loadAcquire() != 0){
+                return false;
+            }
+            const VieVS::Scan &scan = scans[k];
+            bool flag1 = scan.getTimes().getObservingTime(VieVS::Timestamp::start) >= start && scan.getTimes().getObservingTime(VieVS::Timestamp::start) <= end;
+            bool flag2 = scan.getTimes().getObservingTime(VieVS::Timestamp::end)   >= start && scan.getTimes().getObservingTime(VieVS::Timestamp::end) <= end;
+            bool flag3 = scan.getTimes().getObservingTime(VieVS::Timestamp::start) <= start && scan.getTimes().getObservingTime(VieVS::Timestamp::end) >= end;
+            bool flag = flag1 || flag2 || flag3;
+            if(flag){
+                nstas.append(scan.getNSta());
             }
-            for(int i = 0; i<scan.getNObs(); ++i){
-
-                bool flag11 = scan.getObservation(i).getStartTime() >= start && scan.getObservation(i).getStartTime() <= end;
-                bool flag21 = scan.getObservation(i).getStartTime()+scan.getObservation(i).getObservingTime() >= start && scan.getObservation(i).getStartTime()+scan.getObservation(i).getObservingTime() <= end;
-                bool flag31 = scan.getObservation(i).getStartTime() <= start && scan.getObservation(i).getStartTime()+scan.getObservation(i).getObservingTime()   >= end;
-                bool flag01 = flag11 || flag21 || flag31;
-
-                if(flag01){
-                    ++obsStation[scan.getObservation(i).getStaid1()];
-                    ++obsStation[scan.getObservation(i).getStaid2()];
-                    ++obsSource[scan.getSourceId()];
-                    ++scansBaseline[scan.getObservation(i).getBlid()];
+        }
+        staPerScan.fill(start, end, nstas);
+    }
+
+    if(!obsDuration.isCached(start, end)){
+        QVector<double> values;
+        for(size_t k=0; k<scans.size(); ++k){
+            if(cancel != nullptr && (k & 1023) == 0 && cancel->loadAcquire() != 0){
+                return false;
+            }
+            const VieVS::Scan &scan = scans[k];
+            for(int i=0; i<scan.getNSta(); ++i){
+                int tstart = scan.getTimes().getObservingTime(i,VieVS::Timestamp::start);
+                int tend = scan.getTimes().getObservingTime(i,VieVS::Timestamp::end);
+                bool flag1 = tstart >= start && tstart <= end;
+                bool flag2 = tend   >= start && tend <= end;
+                bool flag3 = tstart <= start && tend >= end;
+                bool flag = flag1 || flag2 || flag3;
+                if(flag){
+                    values.append(scan.getTimes().getObservingDuration(i));
                 }
             }
         }
+        obsDuration.fill(start, end, values);
     }
+    return true;
+}
 
-    for(int i=0; i<staModel->rowCount();++i){
-        staModel->setData(staModel->index(i,2), scansStation[i]);
-        staModel->setData(staModel->index(i,3), obsStation[i]);
+bool VieSchedpp_Analyser::windowJobValid() const
+{
+    // results of the last window update can be used if neither the window nor the chart points changed since
+    return !windowWatcher_->isRunning() && !windowJob_.canceled &&
+            windowJob_.start == ui->horizontalSlider_start->value() &&
+            windowJob_.end == ui->horizontalSlider_end->value() &&
+            windowJob_.revision == windowRevision_ &&
+            windowJob_.heatmap == ui->checkBox_skyCoverageHeatmap->isChecked();
+}
+
+void VieSchedpp_Analyser::windowUpdateFinished()
+{
+    int start = ui->horizontalSlider_start->value();
+    int end = ui->horizontalSlider_end->value();
+
+    if(windowJob_.canceled || scanIndex_.windowStart() != start || scanIndex_.windowEnd() != end){
+        // stale result, changed ids are kept in the index and applied together with the next result
+        if(!windowTimer_->isActive()){
+            startWindowUpdate();
+        }
+        return;
     }
-    for(int i=0; i<blModel->rowCount();++i){
-        blModel->setData(blModel->index(i,2), scansBaseline[i]);
+    if(windowApplied_ && appliedStart_ == start && appliedEnd_ == end){
+        return;
     }
-    for(int i=0; i<srcModel->rowCount();++i){
-        srcModel->setData(srcModel->index(i,2), scansSource[i]);
-        srcModel->setData(srcModel->index(i,3), obsSource[i]);
+    applyPlotsAndModels();
+}
+
+void VieSchedpp_Analyser::applyPlotsAndModels()
+{
+    for(int i : scanIndex_.changedStations()){
+        staModel->setData(staModel->index(i,2), scanIndex_.stationScans(i));
+        staModel->setData(staModel->index(i,3), scanIndex_.stationObs(i));
+    }
+    for(int i : scanIndex_.changedBaselines()){
+        blModel->setData(blModel->index(i,2), scanIndex_.baselineObs(i));
+    }
+    for(int i : scanIndex_.changedSources()){
+        srcModel->setData(srcModel->index(i,2), scanIndex_.sourceScans(i));
+        srcModel->setData(srcModel->index(i,3), scanIndex_.sourceObs(i));
+    }
+    scanIndex_.clearChanged();
+
+    windowApplied_ = true;
+    appliedStart_ = scanIndex_.windowStart();
+    appliedEnd_ = scanIndex_.windowEnd();
+
+    // histograms filled on the worker are only taken if their bins did not change meanwhile
+    if(windowJob_.histograms && !windowJob_.canceled){
+        if(windowJob_.staPerScan.edges() == staPerScanHistogram_.edges()){
+            staPerScanHistogram_ = windowJob_.staPerScan;
+        }
+        if(windowJob_.obsDuration.edges() == obsDurationHistogram_.edges()){
+            obsDurationHistogram_ = windowJob_.obsDuration;
+        }
     }
 
     int idx = ui->stackedWidget->currentIndex();
@@ -1947,30 +2294,20 @@ void VieSchedpp_Analyser::updatePlotsAndModels()
 
 void VieSchedpp_Analyser::updateWorldmapTimes()
 {
-    auto chartview = static_cast<ChartView *>(ui->horizontalLayout_worldmap->itemAt(0)->widget());
-    QChart *chart = chartview->chart();
-    const auto &aseries = chart->series();
-    for(const auto &any:aseries){
-        if(any->name() == "observing stations"){
-            QScatterSeries *series = qobject_cast<QScatterSeries *>(any);
-            series->clear();
-
-            for(int i=0; i<staModel->rowCount(); ++i){
-                int n = staModel->index(i,2).data().toInt();
-                if( n > 0){
-                    series->append(staModel->index(i,5).data().toDouble(), staModel->index(i,4).data().toDouble());
-                }
-            }
-        }else if(any->name() != "stations" && any->name() != "coast" ){
-            QString name = any->name().left(5);
+    QVector<QPointF> points;
+    for(int i=0; i<staModel->rowCount(); ++i){
+        int n = staModel->index(i,2).data().toInt();
+        if( n > 0){
+            points.append(stationIndex_.point(i));
+        }
+    }
+    observingStations_->replace(points);
 
-            int row = blModel->findItems(name).at(0)->row();
-            int n = blModel->index(row,2).data().toInt();
-            if(n>0 && ui->checkBox_showBaselines->isChecked()){
-                any->show();
-            }else{
-                any->hide();
-            }
+    bool showBaselines = ui->checkBox_showBaselines->isChecked();
+    for(int blid=0; blid<worldmapBaselines_.size(); ++blid){
+        int n = blModel->index(baselineRow_.at(blid),2).data().toInt();
+        for(QLineSeries *series : worldmapBaselines_.at(blid)){
+            series->setVisible(n>0 && showBaselines);
         }
     }
 }
@@ -1983,22 +2320,15 @@ void VieSchedpp_Analyser::updateSkymapTimes()
     for(const auto &any:aseries){
         if(any->name() == "observed sources"){
             QScatterSeries *series = qobject_cast<QScatterSeries *>(any);
-            series->clear();
 
+            QVector<QPointF> points;
             for(int i=0; i<srcModel->rowCount(); ++i){
                 int n = srcModel->index(i,2).data().toInt();
                 if( n > 0){
-
-                    double ra = srcModel->index(i,4).data().toDouble();
-                    double phi = srcModel->index(i,5).data().toDouble();
-                    double lambda = ra;
-
-
-                    auto xy = qtUtil::radec2xy(lambda*deg2rad, phi*deg2rad);
-
-                    series->append(xy.first, xy.second);
+                    points.append(sourceIndex_.point(i));
                 }
             }
+            series->replace(points);
         }
     }
 }
@@ -2006,7 +2336,6 @@ void VieSchedpp_Analyser::updateSkymapTimes()
 void VieSchedpp_Analyser::updateGeneralStatistics()
 {
     int nsta = schedule_.getNetwork().getNSta();
-    QVector<int> nstaPerScan(nsta+1,0);
     int nsrc = schedule_.getSources().size();
     QVector<int> stations(nsta,0);
     QVector<int> sources(nsrc,0);
@@ -2015,15 +2344,10 @@ void VieSchedpp_Analyser::updateGeneralStatistics()
     int start = ui->horizontalSlider_start->value();
     int end = ui->horizontalSlider_end->value();
 
-    for(const VieVS::Scan &scan : schedule_.getScans()){
-        bool flag1 = scan.getTimes().getObservingTime(VieVS::Timestamp::start) >= start && scan.getTimes().getObservingTime(VieVS::Timestamp::start) <= end;
-        bool flag2 = scan.getTimes().getObservingTime(VieVS::Timestamp::end)   >= start && scan.getTimes().getObservingTime(VieVS::Timestamp::end) <= end;
-        bool flag3 = scan.getTimes().getObservingTime(VieVS::Timestamp::start) <= start && scan.getTimes().getObservingTime(VieVS::Timestamp::end) >= end;
-        bool flag = flag1 || flag2 || flag3;
-        if(flag){
-            ++nstaPerScan[scan.getNSta()];
-        }
-    }
+    // histograms are usually filled by the window update on the worker thread, they are only recomputed here if the
+    // window changed since
+    fillWindowHistograms(start, end, staPerScanHistogram_, obsDurationHistogram_);
+    const QVector<int> &nstaPerScan = staPerScanHistogram_.counts();
     using namespace boost::accumulators;
 
     accumulator_set<double, stats< tag::mean, tag::median, tag::variance, tag::min, tag::max> > accStaScan;
@@ -2142,39 +2466,17 @@ void VieSchedpp_Analyser::updateGeneralStatistics()
 
     QValueAxis *axisY = qobject_cast<QValueAxis *>(barChart->axisY());
 
-    QVector<int> values;
-    for(const VieVS::Scan &scan: schedule_.getScans()){
-        for(int i=0; i<scan.getNSta(); ++i){
-            int tstart = scan.getTimes().getObservingTime(i,VieVS::Timestamp::start);
-            int tend = scan.getTimes().getObservingTime(i,VieVS::Timestamp::end);
-            bool flag1 = tstart >= start && tstart <= end;
-            bool flag2 = tend   >= start && tend <= end;
-            bool flag3 = tstart <= start && tend >= end;
-            bool flag = flag1 || flag2 || flag3;
-            if(flag){
-                values.append(scan.getTimes().getObservingDuration(i));
-            }
-        }
-    }
-    qSort(values.begin(),values.end());
-
-    if(values.empty()){
+    if(obsDurationHistogram_.maxCount() == 0){
         return;
     }
 
-    QVector<int> hist(histogram_upperLimits_.count(),0);
-    for (int any:values) {
-        int i = 0;
-        while(any>=histogram_upperLimits_[i]){
-            ++i;
-        }
-        ++hist[i];
-    }
-    for(auto any: hist){
-        barSet->append(any);
+    QList<qreal> hist;
+    for(int any: obsDurationHistogram_.counts()){
+        hist.append(any);
     }
+    barSet->append(hist);
 
-    axisY->setRange(0, *std::max_element(hist.begin(),hist.end())/10*10+10);
+    axisY->setRange(0, obsDurationHistogram_.maxCount()/10*10+10);
 }
 
 void VieSchedpp_Analyser::statisticsStationsSetup()
@@ -2320,89 +2622,13 @@ void VieSchedpp_Analyser::updateStatisticsStations()
     QVector<double> idle(nsta+1,0);
     QVector<double> preob(nsta+1,0);
     QVector<double> obs(nsta+1,0);
-    QVector<int> eols(nsta+1,0);
-    for(const VieVS::Scan &scan:schedule_.getScans()){
-        for(int i=0; i<scan.getNSta(); ++i){
-            int pos = scan.getStationId(i)+1;
-            VieVS::ScanTimes t = scan.getTimes();
-
-            int fsStart = t.getFieldSystemTime(i,VieVS::Timestamp::start);
-            int fsEnd   = t.getFieldSystemTime(i,VieVS::Timestamp::end);
-            if((fsStart >= start && fsEnd <= end)){
-                fs[pos] += fsEnd-fsStart;     // inside
-            }else if(fsEnd <= start || fsStart >=end){
-                                                // outside
-            }else if(fsStart <= start && fsEnd <= end){
-                fs[pos] += fsEnd-start;       // start outside
-            }else if(fsStart >= start && fsEnd >= end){
-                fs[pos] += end-fsStart;       // end outside
-            }else if((fsStart <= start && fsEnd >= end)){
-                fs[pos] += end-start;         // over
-            }
-
-            int slewStart = t.getSlewTime(i,VieVS::Timestamp::start);
-            int slewEnd   = t.getSlewTime(i,VieVS::Timestamp::end);
-            if((slewStart >= start && slewEnd <= end)){
-                slew[pos] += slewEnd-slewStart;     // inside
-            }else if(slewEnd <= start || slewStart >=end){
-                                                // outside
-            }else if(slewStart <= start && slewEnd <= end){
-                slew[pos] += slewEnd-start;       // start outside
-            }else if(slewStart >= start && slewEnd >= end){
-                slew[pos] += end-slewStart;       // end outside
-            }else if((slewStart <= start && slewEnd >= end)){
-                slew[pos] += end-start;         // over
-            }
-
-
-            int idleStart = t.getIdleTime(i,VieVS::Timestamp::start);
-            int idleEnd   = t.getIdleTime(i,VieVS::Timestamp::end);
-            if((idleStart >= start && idleEnd <= end)){
-                idle[pos] += idleEnd-idleStart;     // inside
-            }else if(idleEnd <= start || idleStart >=end){
-                                                // outside
-            }else if(idleStart <= start && idleEnd <= end){
-                idle[pos] += idleEnd-start;       // start outside
-            }else if(idleStart >= start && idleEnd >= end){
-                idle[pos] += end-idleStart;       // end outside
-            }else if((idleStart <= start && idleEnd >= end)){
-                idle[pos] += end-start;         // over
-            }
-
-            int preobStart = t.getPreobTime(i,VieVS::Timestamp::start);
-            int preobEnd   = t.getPreobTime(i,VieVS::Timestamp::end);
-            if((preobStart >= start && preobEnd <= end)){
-                preob[pos] += preobEnd-preobStart;     // inside
-            }else if(preobEnd <= start || preobStart >=end){
-                                                // outside
-            }else if(preobStart <= start && preobEnd <= end){
-                preob[pos] += preobEnd-start;       // start outside
-            }else if(preobStart >= start && preobEnd >= end){
-                preob[pos] += end-preobStart;       // end outside
-            }else if((preobStart <= start && preobEnd >= end)){
-                preob[pos] += end-start;         // over
-            }
-
-            int obsStart = t.getObservingTime(i,VieVS::Timestamp::start);
-            int obsEnd   = t.getObservingTime(i,VieVS::Timestamp::end);
-            if((obsStart >= start && obsEnd <= end)){
-                obs[pos] += obsEnd-obsStart;     // inside
-            }else if(obsEnd <= start || obsStart >=end){
-                                                // outside
-            }else if(obsStart <= start && obsEnd <= end){
-                obs[pos] += obsEnd-start;       // start outside
-            }else if(obsStart >= start && obsEnd >= end){
-                obs[pos] += end-obsStart;       // end outside
-            }else if((obsStart <= start && obsEnd >= end)){
-                obs[pos] += end-start;         // over
-            }
-
-            int fs_eols = eols[pos];
-            if((fs_eols != fsStart) || (fsEnd != slewStart) || (slewEnd != idleStart) || (idleEnd != preobStart) || (preobEnd != obsStart)){
-                bool invalid = false;
-            }
-            eols[pos] = obsEnd;
-        }
+    for(int i=0; i<nsta; ++i){
+        int pos = i+1;
+        fs[pos]    = timeBudget_.time(i, StationTimeBudget::Activity::fieldSystem, start, end);
+        slew[pos]  = timeBudget_.time(i, StationTimeBudget::Activity::slew, start, end);
+        idle[pos]  = timeBudget_.time(i, StationTimeBudget::Activity::idle, start, end);
+        preob[pos] = timeBudget_.time(i, StationTimeBudget::Activity::preob, start, end);
+        obs[pos]   = timeBudget_.time(i, StationTimeBudget::Activity::observation, start, end);
     }
     fs[0] = std::accumulate(fs.begin(),fs.end(),0)/static_cast<double>(nsta);
     slew[0] = std::accumulate(slew.begin(),slew.end(),0)/static_cast<double>(nsta);
@@ -2597,7 +2823,23 @@ void VieSchedpp_Analyser::updateStatisticsSource()
 
     auto series = chart->series();
 
-    for(VieVS::Station &sta : stations){
+    // elevation tracks are precomputed in the background, compute this source directly if they are not ready yet.
+    // The cache is written by the worker, therefore it is only read after the computation finished.
+    int step = ElevationTrackCache::defaultStep;
+    int nSamples = ElevationTrackCache::sampleCount(ui->horizontalSlider_end->maximum(), step);
+    QVector<float> tmp;
+    const float *tracks;
+    if(elevationCacheFuture_.isFinished() && elevationCache_.step() == step && elevationCache_.samples() == nSamples){
+        tracks = elevationCache_.track(idx,0);
+    }else{
+        tmp.resize(stations.size()*nSamples);
+        ElevationTrackCache::computeSource(stations, src, step, nSamples, tmp.data());
+        tracks = tmp.constData();
+    }
+
+    qint64 t0 = sessionStart_.toMSecsSinceEpoch();
+    for(int i=0; i<static_cast<int>(stations.size()); ++i){
+        const VieVS::Station &sta = stations[i];
 
         QLineSeries *serie;
         for(const auto &any:series){
@@ -2606,18 +2848,13 @@ void VieSchedpp_Analyser::updateStatisticsSource()
                 break;
             }
         }
-        serie->clear();
 
-        for(int i = 0; i<=ui->horizontalSlider_end->maximum()+300; i+=300){
-            QDateTime t = sessionStart_.addSecs(i);
-
-            VieVS::PointingVector pv(sta.getId(),src.getId());
-            pv.setTime(i);
-
-            sta.calcAzEl_rigorous(src,pv);
-            double el = pv.getEl()*rad2deg;
-            serie->append(t.toMSecsSinceEpoch(),el);
+        const float *el = tracks + static_cast<size_t>(i)*nSamples;
+        QVector<QPointF> points(nSamples);
+        for(int k=0; k<nSamples; ++k){
+            points[k] = QPointF(t0 + static_cast<qint64>(k)*step*1000, el[k]);
         }
+        serie->replace(points);
 
         serie->attachAxis(chart->axisX());
         serie->attachAxis(chart->axisY());
@@ -2988,12 +3225,8 @@ void VieSchedpp_Analyser::statisticsBaselineSetup()
 
     connect(stationsSeries,SIGNAL(hovered(QPointF,bool)),this,SLOT(worldmap_hovered(QPointF,bool)));
 
+    stationsSeries->replace(stationIndex_.points());
     const std::vector<VieVS::Station> &stations = schedule_.getNetwork().getStations();
-    for(const VieVS::Station &station : stations){
-        double lat = station.getPosition().getLat()*rad2deg;
-        double lon = station.getPosition().getLon()*rad2deg;
-        stationsSeries->append(lon,lat);
-    }
     for(int i=0; i<stations.size(); ++i){
         double lat1 = stations.at(i).getPosition().getLat()*rad2deg;
         double lon1 = stations.at(i).getPosition().getLon()*rad2deg;
@@ -3225,6 +3458,8 @@ void VieSchedpp_Analyser::setUVCoverageLayout(int rows, int columns)
             delete itm->layout();
         }
     }
+    uvSeries_ = QVector<UVSeries>(rows*columns);
+    ++windowRevision_;
 
     int counter = 0;
     for(int i=0; i<rows; ++i){
@@ -3356,64 +3591,41 @@ void VieSchedpp_Analyser::updateUVCoverage(int idx, QString source, QString band
 
 
     int srcid = srcModel->findItems(source).at(0)->row();
-    const VieVS::Network &network = schedule_.getNetwork();
-    const std::vector<VieVS::Source> &sources = schedule_.getSources();
-
-    double max = 0;
+    const UVCoverageCache &cache = uvCache();
+    s->setBaselineNames(cache.baselineNames());
+    ss->setBaselineNames(cache.baselineNames());
 
-    for(const VieVS::Scan &scan: schedule_.getScans()){
-        if(scan.getSourceId() == srcid){
-            for(const VieVS::Observation &obs: scan.getObservations()){
-                unsigned long staid1 = obs.getStaid1();
-                unsigned long staid2 = obs.getStaid2();
-                int idx1 = *scan.findIdxOfStationId(staid1);
-                int idx2 = *scan.findIdxOfStationId(staid2);
-                const std::vector<double> &dxyz = network.getDxyz(staid1,staid2);
-                double x = dxyz[0];
-                double y = dxyz[1];
-                double z = dxyz[2];
-
-                double mjd = sessionStartMjd_ + obs.getStartTime()/86400.0;
-                double gmst  = iauGmst82(2400000.5,mjd);
-                std::pair<double, double> uv = sources.at(srcid).calcUV(gmst, dxyz);
-
-                QString bl = QString::fromStdString(network.getStation(staid1).getAlternativeName()+"-"+network.getStation(staid2).getAlternativeName());
-                int start = std::max({scan.getTimes().getObservingTime(idx1,VieVS::Timestamp::start), scan.getTimes().getObservingTime(idx2,VieVS::Timestamp::start)});
-                int end   = std::min({scan.getTimes().getObservingTime(idx1,VieVS::Timestamp::end),   scan.getTimes().getObservingTime(idx2,VieVS::Timestamp::end)});
-
-                if(band == "-"){
-
-                    double u  = uv.first  * 1e-6;
-                    double v  = uv.second * 1e-6;
-
-                    if( fabs(u) > max){
-                        max = fabs(u);
-                    }
-                    if( fabs(v) > max){
-                        max = fabs(v);
-                    }
-                    s->append( u,  v, start, end, bl, -1);
-                    s->append(-u, -v, start, end, bl, -1);
-
-                }else{
-                    const QVector<double> &freq = freqs_[band];
-
-                    for( double f : freq){
-
-                        double u  = uv.first  * 1e-6 * f / CMPS;
-                        double v  = uv.second * 1e-6 * f / CMPS;
-
-                        if(fabs(u) > max){
-                            max = fabs(u);
-                        }
-                        if(fabs(v) > max){
-                            max = fabs(v);
-                        }
-                        s->append( u,  v, start, end, bl, f);
-                        s->append(-u, -v, start, end, bl, f);
+    // u/v are cached in meters, scale to [1000 km] or [10^6 wavelength]
+    QVector<double> freq;
+    QVector<double> scale;
+    if(band == "-"){
+        freq.append(-1);
+        scale.append(1e-6);
+    }else{
+        freq = freqs_[band];
+        for( double f : freq){
+            scale.append(1e-6 * f / CMPS);
+        }
+    }
 
-                    }
-                }
+    double max = 0;
+    WindowPoints points;
+    for(const UVCoverageCache::Point &p : cache.points(srcid)){
+        for(int i=0; i<freq.size(); ++i){
+            double u = p.u * scale[i];
+            double v = p.v * scale[i];
+
+            if(fabs(u) > max){
+                max = fabs(u);
+            }
+            if(fabs(v) > max){
+                max = fabs(v);
+            }
+            s->append( u,  v, p.startTime, p.endTime, p.blid, freq[i]);
+            s->append(-u, -v, p.startTime, p.endTime, p.blid, freq[i]);
+            for(int k=0; k<2; ++k){
+                points.startTime.append(p.startTime);
+                points.endTime.append(p.endTime);
             }
         }
     }
@@ -3452,6 +3664,11 @@ void VieSchedpp_Analyser::updateUVCoverage(int idx, QString source, QString band
     connect(s,SIGNAL(hovered(QPointF,bool)),this,SLOT(uvHovered(QPointF,bool)));
     connect(ss,SIGNAL(hovered(QPointF,bool)),this,SLOT(uvHovered(QPointF,bool)));
 
+    uvSeries_[idx].data = s;
+    uvSeries_[idx].uv = ss;
+    uvSeries_[idx].points = points;
+    ++windowRevision_;
+
     updateUVTimes(idx);
 
 }
@@ -3509,51 +3726,35 @@ void VieSchedpp_Analyser::uvHovered(QPointF point, bool flag)
 
 void VieSchedpp_Analyser::updateUVTimes()
 {
-    for(int i=0; i<ui->gridLayout_uv_coverage->count(); ++i){
-        updateUVTimes(i);
+    // the uv points inside the window are usually already selected by the window update on the worker thread
+    if(!windowJobValid() || windowJob_.uvIds.size() != uvSeries_.size()){
+        for(int i=0; i<uvSeries_.size(); ++i){
+            updateUVTimes(i);
+        }
+        return;
+    }
+    for(int i=0; i<uvSeries_.size(); ++i){
+        const UVSeries &handles = uvSeries_.at(i);
+        if(handles.data != nullptr){
+            handles.uv->replaceWith(handles.data, windowJob_.uvIds.at(i));
+        }
     }
-
 }
 
 void VieSchedpp_Analyser::updateUVTimes(int idx)
 {
-    QGroupBox *box = qobject_cast<QGroupBox*>(ui->gridLayout_uv_coverage->itemAt(idx)->widget());
-    QChartView *chartView = qobject_cast<QChartView*>(box->layout()->itemAt(1)->widget());
-    QChart *chart = chartView->chart();
-
-    QList<QAbstractSeries *> series = chart->series();
-    QScatterSeriesUV * data;
-    QScatterSeriesUV * uv;
-
-    for(const auto &any:series){
-        if(any->name() == "outside timespan"){
-            data = static_cast<QScatterSeriesUV *>(any);
-        }
-        if(any->name() == "uv"){
-            uv = static_cast<QScatterSeriesUV *>(any);
-        }
+    const UVSeries &handles = uvSeries_.at(idx);
+    QScatterSeriesUV *data = handles.data;
+    if(data == nullptr){
+        return;
     }
 
-    uv->clear();
-
     int start = ui->horizontalSlider_start->value();
     int end = ui->horizontalSlider_end->value();
 
-    for(int i=0; i<data->count(); ++i){
-        bool flag1 = data->getStartTime(i) >= start && data->getStartTime(i) <= end;
-        bool flag2 = data->getEndTime(i) >= start && data->getEndTime(i) <= end;
-        bool flag3 = data->getStartTime(i) <= start && data->getEndTime(i) >= end;
-        bool flag = flag1 || flag2 || flag3;
-
-        if(flag){
-            uv->append(data->at(i).x(),
-                       data->at(i).y(),
-                       data->getStartTime(i),
-                       data->getEndTime(i),
-                       data->getBl(i),
-                       data->getFreq(i));
-        }
-    }
+    QVector<QVector<int>> ids(1);
+    pointsInWindow(handles.points, start, end, ids);
+    handles.uv->replaceWith(data, ids.at(0));
 
 }
 
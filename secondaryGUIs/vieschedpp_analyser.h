@@ -49,6 +49,22 @@
 #include <QMessageBox>
 #include <QProgressBar>
 #include <QDesktopServices>
+#include <memory>
+#include <QFuture>
+#include <QFutureWatcher>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QStatusBar>
+#include <QProgressDialog>
+#include <QThread>
+#include <QEventLoop>
+#include <QHash>
+#include <QAtomicInt>
+#include <QBuffer>
+#include <QtConcurrent/QtConcurrentRun>
+#include <QtConcurrent/QtConcurrentMap>
+#include <functional>
+#include <numeric>
 
 #include <secondaryGUIs/rendersetup.h>
 
@@ -64,6 +80,15 @@
 #include "../VieSchedpp/Scheduler.h"
 #include "Utility/qtutil.h"
 #include "Utility/callout.h"
+#include "Utility/scanintervalindex.h"
+#include "Utility/stationtimebudget.h"
+#include "Utility/uvcoveragecache.h"
+#include "Utility/elevationtrackcache.h"
+#include "Utility/offscreenplot.h"
+#include "Utility/animatedpngwriter.h"
+#include "Utility/pointindex.h"
+#include "Utility/polarheatmap.h"
+#include "Utility/histogram.h"
 
 QT_CHARTS_USE_NAMESPACE
 
@@ -71,12 +96,26 @@ namespace Ui {
 class VieSchedpp_Analyser;
 }
 
+class QScatterSeriesExtended;
+class QScatterSeriesUV;
+
 class VieSchedpp_Analyser : public QMainWindow
 {
     Q_OBJECT
 
 public:
-    explicit VieSchedpp_Analyser(VieVS::Scheduler schedule, std::map<std::string, std::vector<double>> freqs, QDateTime start, QDateTime end, QWidget *parent = 0);
+    /**
+     * @brief analyser window
+     *
+     * The schedule is shared and never modified, several windows can analyse the same parsed schedule without copying it.
+     *
+     * @param schedule shared schedule
+     * @param freqs frequencies per band [MHz]
+     * @param start session start
+     * @param end session end
+     * @param parent parent widget
+     */
+    explicit VieSchedpp_Analyser(std::shared_ptr<const VieVS::Scheduler> schedule, std::map<std::string, std::vector<double>> freqs, QDateTime start, QDateTime end, QWidget *parent = 0);
     ~VieSchedpp_Analyser();
 
     void setup();
@@ -133,6 +172,10 @@ private slots:
 
     void on_treeView_skyCoverage_sources_clicked(const QModelIndex &index);
 
+    void setupSkyCoverage();
+
+    void setupUVCoverage();
+
     void setupWorldmap();
 
     void worldmap_hovered(QPointF point, bool state);
@@ -157,7 +200,11 @@ private slots:
 
     void timePerObservation_hovered(bool state, int idx);
 
-    void updatePlotsAndModels();
+    void scheduleUpdatePlotsAndModels();
+
+    void startWindowUpdate();
+
+    void windowUpdateFinished();
 
     void updateWorldmapTimes();
 
@@ -171,6 +218,8 @@ private slots:
 
     void on_checkBox_skyCoverageLegend_toggled(bool checked);
 
+    void on_checkBox_skyCoverageHeatmap_toggled(bool checked);
+
     void statisticsStationsSetup();
 
     void updateStatisticsStations();
@@ -253,7 +302,8 @@ private slots:
 private:
     Ui::VieSchedpp_Analyser *ui;
 
-    VieVS::Scheduler schedule_;
+    std::shared_ptr<const VieVS::Scheduler> scheduleHandle_;
+    const VieVS::Scheduler &schedule_;
     QMap<QString, QVector<double>> freqs_;
     QDateTime sessionStart_;
     double sessionStartMjd_;
@@ -263,7 +313,187 @@ private:
     QStandardItemModel *staModel;
     QStandardItemModel *blModel;
 
-    QList<int> histogram_upperLimits_;
+    Histogram staPerScanHistogram_;     ///< number of scans per number of participating stations
+    Histogram obsDurationHistogram_;    ///< number of observations per observing duration
+
+    PointIndex stationIndex_;       ///< map positions (lon, lat) of stations
+    PointIndex sourceIndex_;        ///< sky map positions of sources
+
+    /**
+     * @brief observing times of the points of one chart
+     *
+     * Plain copy of the times stored in the chart series, so the points inside a time window can be selected on a
+     * worker thread without touching the series.
+     */
+    struct WindowPoints{
+        QVector<int> startTime;                         ///< start time of each point
+        QVector<int> endTime;                           ///< end time of each point
+        QVector<char> group;                            ///< output group of each point (empty: all in group 0)
+    };
+
+    /**
+     * @brief series of one sky coverage chart
+     */
+    struct SkyCoverageSeries{
+        QScatterSeriesExtended *data = nullptr;         ///< all pointings ("outside timespan")
+        QScatterSeriesExtended *n = nullptr;            ///< pointings inside window, neutral cable wrap
+        QScatterSeriesExtended *ccw = nullptr;          ///< pointings inside window, counter clockwise cable wrap
+        QScatterSeriesExtended *cw = nullptr;           ///< pointings inside window, clockwise cable wrap
+        QScatterSeriesExtended *selected = nullptr;     ///< pointings of selected sources
+        WindowPoints points;                            ///< times of all pointings, group 0: n, 1: ccw, 2: cw
+    };
+    QVector<SkyCoverageSeries> skyCoverageSeries_;      ///< per chart in gridLayout_skyCoverage
+
+    /**
+     * @brief series of one uv coverage chart
+     */
+    struct UVSeries{
+        QScatterSeriesUV *data = nullptr;               ///< all uv points ("outside timespan")
+        QScatterSeriesUV *uv = nullptr;                 ///< uv points inside window
+        WindowPoints points;                            ///< times of all uv points
+    };
+    QVector<UVSeries> uvSeries_;                        ///< per chart in gridLayout_uv_coverage
+
+    QScatterSeries *observingStations_ = nullptr;       ///< world map stations with scans inside window
+    QVector<int> baselineRow_;                          ///< blModel row per baseline id
+    QVector<QList<QLineSeries *>> worldmapBaselines_;   ///< world map series per baseline id
+
+    QVector<bool> tabInitialized_;
+
+    /**
+     * @brief build charts of a tab if it was not shown before
+     *
+     * The construction time is reported in the status bar.
+     *
+     * @param idx index in stackedWidget
+     * @return true if the tab was initialized now
+     */
+    bool initializeTab(int idx);
+
+    void showTab(int idx);
+
+    /**
+     * @brief input and result of one time window update
+     *
+     * The input is copied on the GUI thread when the update starts (implicitly shared, no deep copy). The worker
+     * selects the points inside the window for the charts of the visible tab and fills the histograms, the GUI thread
+     * only passes the result to the series and models.
+     */
+    struct WindowJob{
+        int start = 0;
+        int end = 0;
+        int revision = 0;                               ///< windowRevision_ of the copied chart points
+        bool heatmap = false;                           ///< sky coverage heatmap mode (no single pointings)
+        bool histograms = false;                        ///< fill histograms of general statistics
+        bool canceled = false;                          ///< stopped because a newer window was requested
+        QVector<WindowPoints> skyCoverage;              ///< points per sky coverage chart
+        QVector<WindowPoints> uv;                       ///< points per uv chart
+        QVector<QVector<QVector<int>>> skyCoverageIds;  ///< point ids inside window per sky coverage chart and group
+        QVector<QVector<int>> uvIds;                    ///< point ids inside window per uv chart
+        Histogram staPerScan;                           ///< copy of staPerScanHistogram_
+        Histogram obsDuration;                          ///< copy of obsDurationHistogram_
+    };
+
+    ScanIntervalIndex scanIndex_;
+    QTimer *windowTimer_;
+    QFutureWatcher<void> *windowWatcher_;
+    WindowJob windowJob_;
+    QAtomicInt windowCancel_;                           ///< set to stop a running window update
+    int windowRevision_;                                ///< incremented whenever the points of a chart change
+    bool windowApplied_;
+    int appliedStart_;
+    int appliedEnd_;
+
+    void prepareWindowJob();
+
+    void computeWindow(WindowJob &job);
+
+    /**
+     * @brief select points inside a time window
+     *
+     * @param points observing times of all points
+     * @param start window start time
+     * @param end window end time
+     * @param ids point ids inside the window per group (sized by caller)
+     * @param cancel checked regularly, selection stops if it is set
+     * @return false if the selection was canceled
+     */
+    static bool pointsInWindow(const WindowPoints &points, int start, int end, QVector<QVector<int>> &ids,
+                               const QAtomicInt *cancel = nullptr);
+
+    /**
+     * @brief fill general statistics histograms for a time window
+     *
+     * Histograms which already belong to this window are not filled again. Only reads the schedule, can therefore be
+     * called from the worker thread.
+     *
+     * @param start window start time
+     * @param end window end time
+     * @param staPerScan number of scans per number of participating stations
+     * @param obsDuration number of observations per observing duration
+     * @param cancel checked regularly, filling stops if it is set
+     * @return false if filling was canceled
+     */
+    bool fillWindowHistograms(int start, int end, Histogram &staPerScan, Histogram &obsDuration,
+                              const QAtomicInt *cancel = nullptr) const;
+
+    bool windowJobValid() const;
+
+    void setSkyCoverageTimes(int idx, const QVector<QVector<int>> &ids);
+
+    void applyPlotsAndModels();
+    StationTimeBudget timeBudget_;
+
+    UVCoverageCache uvCache_;
+    QFuture<void> uvCacheFuture_;
+
+    const UVCoverageCache &uvCache();
+
+    ElevationTrackCache elevationCache_;
+    QFuture<void> elevationCacheFuture_;
+
+    const ElevationTrackCache &elevationCache();
+
+    /**
+     * @brief render and save images of a batch export
+     *
+     * The images are rendered and encoded concurrently on the global thread pool, a progress dialog allows to cancel
+     * the export. The charts of the analyser are not touched.
+     *
+     * @param jobs images to render (saved flag is set)
+     * @param render render function, called from worker threads
+     * @param outDir output directory
+     */
+    void exportImages(QVector<OffscreenPlot::Job> &jobs, const std::function<QImage(const OffscreenPlot::Job &)> &render,
+                      const QString &outDir);
+
+    /**
+     * @brief render and save frames of time-lapse animations
+     *
+     * All frames are saved as numbered png files and the frames of each plot item are combined into one animated png.
+     * Frames are rendered and encoded concurrently in small chunks and streamed to the animation file, so memory usage
+     * does not depend on the number of frames.
+     *
+     * @param jobs frames to render, frames of one item must be consecutive (saved flag is set)
+     * @param render render function, called from worker threads
+     * @param animations animation file name per item
+     * @param delay display time of each frame in milliseconds
+     * @param outDir output directory
+     */
+    void exportAnimation(QVector<OffscreenPlot::Job> &jobs, const std::function<QImage(const OffscreenPlot::Job &)> &render,
+                         const QVector<QString> &animations, int delay, const QString &outDir);
+
+    void showExportResult(const QString &text, bool warning, const QString &outDir);
+
+    QString exportTitle(const QString &name, int start, int end) const;
+
+    /**
+     * @brief heatmap item of a sky coverage chart
+     *
+     * @param chart sky coverage chart
+     * @return heatmap item (nullptr if chart has none)
+     */
+    static PolarHeatmap *skyCoverageHeatmap(QChart *chart);
 
 //    QSignalMapper *comboBox2skyCoverage;
 
@@ -313,6 +543,33 @@ public:
         return cableWrap_.at(idx);
     }
 
+    /**
+     * @brief replace all points by a subset of the points of another series
+     *
+     * The points are set with a single QXYSeries::replace() call instead of one signal per point.
+     *
+     * @param from series holding the points
+     * @param ids indices of the points in from
+     */
+    void replaceWith(const QScatterSeriesExtended *from, const QVector<int> &ids){
+        QVector<QPointF> points;
+        points.reserve(ids.size());
+        startTime_.clear();
+        endTime_.clear();
+        cableWrap_.clear();
+        srcid_.clear();
+        nsta_.clear();
+        for(int i : ids){
+            points.append(from->at(i));
+            startTime_.append(from->startTime_.at(i));
+            endTime_.append(from->endTime_.at(i));
+            cableWrap_.append(from->cableWrap_.at(i));
+            srcid_.append(from->srcid_.at(i));
+            nsta_.append(from->nsta_.at(i));
+        }
+        QScatterSeries::replace(points);
+    }
+
 private:
     QVector<int> startTime_;
     QVector<int> endTime_;
@@ -370,12 +627,27 @@ public:
         QScatterSeries(parent){
     }
 
+    /**
+     * @brief set table of baseline names
+     *
+     * Points only store the baseline id, names are resolved from this (implicitly shared) table when requested.
+     *
+     * @param names baseline name per baseline id
+     */
+    void setBaselineNames(const QVector<QString> &names){
+        blNames_ = names;
+    }
+
+    const QVector<QString> &getBaselineNames(){
+        return blNames_;
+    }
+
     void append(double x, double y, int startTime, int endTime,
-                QString bl, double freq){
+                int blid, double freq){
         QScatterSeries::append(x,y);
         startTime_.append(startTime);
         endTime_.append(endTime);
-        bls_.append(bl);
+        blid_.append(blid);
         freqs_.append(freq);
     }
 
@@ -383,7 +655,7 @@ public:
         QScatterSeries::clear();
         startTime_.clear();
         endTime_.clear();
-        bls_.clear();
+        blid_.clear();
         freqs_.clear();
     }
 
@@ -395,19 +667,49 @@ public:
         return endTime_.at(idx);
     }
 
+    int getBlid(int idx){
+        return blid_.at(idx);
+    }
+
     QString getBl(int idx){
-        return bls_.at(idx);
+        return blNames_.at(blid_.at(idx));
     }
 
     double getFreq(int idx){
         return freqs_.at(idx);
     }
 
+    /**
+     * @brief replace all points by a subset of the points of another series
+     *
+     * The points are set with a single QXYSeries::replace() call instead of one signal per point.
+     *
+     * @param from series holding the points
+     * @param ids indices of the points in from
+     */
+    void replaceWith(const QScatterSeriesUV *from, const QVector<int> &ids){
+        QVector<QPointF> points;
+        points.reserve(ids.size());
+        startTime_.clear();
+        endTime_.clear();
+        blid_.clear();
+        freqs_.clear();
+        for(int i : ids){
+            points.append(from->at(i));
+            startTime_.append(from->startTime_.at(i));
+            endTime_.append(from->endTime_.at(i));
+            blid_.append(from->blid_.at(i));
+            freqs_.append(from->freqs_.at(i));
+        }
+        QScatterSeries::replace(points);
+    }
+
 private:
     QVector<int> startTime_;
     QVector<int> endTime_;
-    QVector<QString> bls_;
+    QVector<int> blid_;
     QVector<double> freqs_;
+    QVector<QString> blNames_;
 };
 
 